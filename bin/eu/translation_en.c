@@ -6,10 +6,11 @@
 
 #include "make_const_nonconst.h"
 
-// Include text/define_text.inc.c, preprocessed with -I text/us/ to get the
+// Include text/define_dialogs.inc.c and text/define_text.inc.c, preprocessed with -I text/us/ to get the
 // right translation strings, with symbols renamed as below.
 #define seg2_course_name_table course_name_table_eu_en
 #define seg2_act_name_table act_name_table_eu_en
 #define seg2_dialog_table dialog_table_eu_en
 
+#include "text/us/define_dialogs.inc.c"
 #include "text/us/define_text.inc.c"
@@ -6,10 +6,11 @@
 
 #include "make_const_nonconst.h"
 
-// Include text/define_text.inc.c, preprocessed with -I text/fr/ to get the
+// Include text/define_dialogs.inc.c and text/define_text.inc.c, preprocessed with -I text/fr/ to get the
 // right translation strings, with symbols renamed as below.
 #define seg2_course_name_table course_name_table_eu_fr
 #define seg2_act_name_table act_name_table_eu_fr
 #define seg2_dialog_table dialog_table_eu_fr
 
+#include "text/fr/define_dialogs.inc.c"
 #include "text/fr/define_text.inc.c"
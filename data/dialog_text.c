@@ -0,0 +1,18 @@
+#include <PR/ultratypes.h>
+
+#include "config.h"
+#include "macros.h"
+#include "types.h"
+#include "game/ingame_menu.h"
+
+#include "make_const_nonconst.h"
+
+// Dialog text that stays in ROM, linked at SEGMENT_DIALOG_TEXT and read with rom_segment_read.
+// Without ROM_RESIDENT_DIALOG, the dialogs are part of segment 2 (bin/segment2.c).
+#ifdef ROM_RESIDENT_DIALOG
+#if defined(VERSION_JP) || defined(VERSION_SH)
+#include "text/jp/define_dialogs.inc.c"
+#elif defined(VERSION_US)
+#include "text/us/define_dialogs.inc.c"
+#endif
+#endif
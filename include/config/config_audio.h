@@ -50,3 +50,22 @@
  * Reverb presets can be configured in audio/data.c to meet desired aesthetic/performance needs. More detailed usage info can also be found on the HackerSM64 Wiki page.
  */
 // #define BETTER_REVERB
+
+/**
+ * Lowers audio quality at runtime when the audio thread or the audio RSP task goes over budget for a while, and raises it
+ * again once there's enough headroom. Fewer notes are allowed to play at once right away (extra notes steal or get dropped
+ * like when the note limit is hit), and the reverb is downsampled further on the next audio_reset_session (usually a level or
+ * area transition). The budgets are in microseconds per audio update (60 per second). Requires USE_PROFILER.
+ */
+// #define AUDIO_QUALITY_GOVERNOR
+#define AUDIO_GOVERNOR_CPU_BUDGET 2500
+#define AUDIO_GOVERNOR_RSP_BUDGET 2500
+
+/**
+ * Decodes layer scripts (the note data of a sequence) into fixed width ops the first time a channel starts them, and plays them from
+ * there every time after that instead of parsing the m64 bytecode again. The decoded ops are kept until the sequence player loads
+ * another sequence. Each sequence player gets PREDECODE_SEQUENCES_MAX_OPS ops (8 bytes each); layers that don't fit are played from
+ * the bytecode like before.
+ */
+// #define PREDECODE_SEQUENCES
+#define PREDECODE_SEQUENCES_MAX_OPS 2048
@@ -52,6 +52,24 @@
  */
 // #define PUPPYPRINT_DEBUG_CYCLES
 
+/**
+ * Records timestamped begin/end events for object updates, the audio update and display list submission, plus per frame
+ * find_floor totals, into a ring buffer, which can be viewed on the crash screen. With UNF, new events are also sent over USB
+ * every frame. See event_trace.h for the packet format, and tools/event_trace_to_chrome.py to view them.
+ */
+// #define EVENT_TRACER
+
+/**
+ * The number of events the event tracer ring buffer holds. Must be a power of 2.
+ */
+#define EVENT_TRACE_BUFFER_SIZE 1024
+
+/**
+ * Measures the time each behavior spends in its object updates, and shows the 10 slowest on the "Behaviors" puppyprint page.
+ * With UNF, press A on that page to send every behavior's totals over USB. Requires PUPPYPRINT_DEBUG.
+ */
+// #define BEHAVIOR_PROFILER
+
 /**
  * A vanilla style debug mode. It doesn't rely on a text engine, but it's much less powerful that PUPPYPRINT_DEBUG.
  * Press D-pad left to show the debug UI.
@@ -152,3 +152,28 @@
  * Only use this if you can test the difference of your hack with and without this change on console.
  */
 // #define USE_FRUSTRATIO2
+
+/**
+ * Keeps a copy of each model graph built from a geo layout, so loading the same geo layout again (like the common
+ * models that are loaded on every level load) only copies the prebuilt nodes and relocates their pointers instead of
+ * interpreting the geo layout again. Geo functions of cached models must not rely on GEO_CONTEXT_CREATE.
+ */
+// #define GEO_LAYOUT_CACHE
+
+/**
+ * The amount of memory used to store cached model graphs with GEO_LAYOUT_CACHE, and the maximum number of them.
+ */
+#define GEO_LAYOUT_CACHE_SIZE    0x8000
+#define GEO_LAYOUT_CACHE_ENTRIES 128
+
+/**
+ * Keeps the matrices of translation, rotation, scale, animated part and object nodes across frames, so they're only
+ * recomputed and converted to fixed point when their parent matrix or their own transform changed since the last frame.
+ * Costs MATRIX_CACHE_ENTRIES * 0x100 bytes of RAM.
+ */
+// #define MATRIX_CACHE
+
+/**
+ * The number of node matrices MATRIX_CACHE can keep. Nodes that don't fit have their matrix recomputed every frame.
+ */
+#define MATRIX_CACHE_ENTRIES 256
@@ -141,3 +141,22 @@
  */
 #define MARIO_INERTIA_UPWARD
 // #define MARIO_INERTIA_LATERAL
+
+/**
+ * Splits Mario's ground and air movement into a number of steps based on his speed, instead of always taking 4 quarter steps.
+ * Slow movement (most frames) only does a single set of collision checks, and fast movement takes as many steps as needed
+ * to never move further than MARIO_STEP_MAX_DIST per step. This changes the subframe collision behavior speedruns and
+ * TASes depend on, so leave this disabled to keep the vanilla quarter step semantics.
+ */
+// #define ADAPTIVE_MARIO_STEPS
+
+/**
+ * The furthest Mario can move in a single step with ADAPTIVE_MARIO_STEPS. Vanilla moves up to 24 units per quarter step
+ * at the ground speed cap (the lower wall radius), and 18.75 units per quarter step at terminal velocity.
+ */
+#define MARIO_STEP_MAX_DIST 24.0f
+
+/**
+ * The maximum number of steps Mario can take per frame with ADAPTIVE_MARIO_STEPS.
+ */
+#define MARIO_STEP_MAX_STEPS 8
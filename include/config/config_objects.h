@@ -4,6 +4,40 @@
  * SPECIFIC OBJECT SETTINGS *
  ****************************/
 
+/***********************
+ * -- OBJECT LOADING --
+ ***********************/
+
+/**
+ * Instead of spawning every object in an area when it loads, objects are put into a spawn index sorted by collision cell
+ * and only spawned once Mario or the camera get within LAZY_SPAWN_RADIUS of them. They get unloaded again once they are
+ * further than LAZY_DESPAWN_RADIUS from both, and respawn from their spawn info when coming back into range.
+ * This reduces load times and allows areas to have more objects than the object pool can hold at once.
+ * Only general actors, pushable, default and unimportant objects are streamed, everything else is spawned on area load.
+ * NOTE: Objects that search for or count other objects may not find them if they haven't been spawned yet.
+ */
+// #define LAZY_OBJECT_SPAWNING
+
+/**
+ * The distance at which streamed objects get spawned, and the (larger) distance at which they get unloaded again.
+ */
+#define LAZY_SPAWN_RADIUS   6000.0f
+#define LAZY_DESPAWN_RADIUS 7000.0f
+
+/**
+ * The maximum number of streamed objects per area. Any objects past this are spawned on area load.
+ */
+#define LAZY_SPAWN_INDEX_SIZE 512
+
+/**
+ * EXPERIMENTAL: Links behaviors that are only used in one level (see src/overlays/) into their own segment, which that
+ * level's script loads into TLB mapped memory with LOAD_RAW_WITH_CODE and which is freed again when the level is cleared.
+ * Only Tick Tock Clock's behaviors are split out, as a test case for the segment and its -mlong-calls build. This build
+ * hasn't been linked or run yet, and how much engine RAM it frees hasn't been measured, so leave it off for real hacks.
+ * NOTE: Together with the other code segments a level loads, overlays must fit within the 256KB the TLB can map.
+ */
+// #define BEHAVIOR_OVERLAYS
+
 /**************
  * -- COIN --
  **************/
@@ -109,6 +143,7 @@
 
 /**
  * The number of chain balls the Chain Chomp has. Vanilla is 5.
+ * The chain is stored in an object sidecar, so going above 6 requires raising OBJECT_SIDECAR_SIZE.
  */
 #define CHAIN_CHOMP_NUM_SEGMENTS 5
 
@@ -127,5 +162,6 @@
 
 /**
  * The number of segments Wiggler has, not including the head. Vanilla is 4.
+ * The segments are stored in an object sidecar, so going above 6 requires raising OBJECT_SIDECAR_SIZE.
  */
 #define WIGGLER_NUM_SEGMENTS     4
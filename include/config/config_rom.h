@@ -60,3 +60,43 @@
  * Might break on some emulators. Use at your own risk, and don't use it unless you actually need the extra performance.
  */
 // #define RCVI_HACK
+
+/**
+ * Keeps actor group and skybox segments decompressed in a reserved region at the top of RAM after they're unloaded,
+ * keyed by their ROM address. Loading the same segment again, like the common actor groups when warping between the
+ * castle and a course, just points the segment at the cached copy instead of reading and decompressing it again.
+ * The least recently used segments are evicted when the cache is full.
+ * Level data is always decompressed again, since objects write to it at runtime (like respawn flags in macro objects).
+ */
+// #define SEGMENT_CACHE
+
+/**
+ * The amount of RAM taken away from the main pool for SEGMENT_CACHE, and the maximum number of segments it can hold.
+ */
+#define SEGMENT_CACHE_SIZE    0x200000
+#define SEGMENT_CACHE_ENTRIES 16
+
+/**
+ * Leaves the dialog text in ROM instead of decompressing it into RAM with the rest of segment 2, saving around 30KB.
+ * When a dialog is opened, its entry and text are read from ROM into a ROM_RESIDENT_DIALOG_BUFFER_SIZE byte buffer.
+ * NOTE: Not supported in EU, where the dialog text is part of the translation segments.
+ */
+// #define ROM_RESIDENT_DIALOG
+
+/**
+ * The longest dialog text ROM_RESIDENT_DIALOG can hold. Longer dialogs get cut off.
+ */
+#define ROM_RESIDENT_DIALOG_BUFFER_SIZE 1024
+
+/**
+ * Lets levels start before their actor group segments (models, animations and collision of the level's objects) are
+ * decompressed. Those segments are decompressed one per frame once gameplay starts, or right away when something uses
+ * them first. This shortens the black screen when entering a level, at the cost of some slower frames afterwards.
+ * Works best with LAZY_OBJECT_SPAWNING, since objects that are spawned on area load use their segments immediately.
+ */
+// #define STREAM_LEVEL_SEGMENTS
+
+/**
+ * The maximum number of segments STREAM_LEVEL_SEGMENTS can have waiting to be decompressed at once.
+ */
+#define STREAM_MAX_SEGMENTS 4
@@ -49,6 +49,10 @@
     #undef BETTER_REVERB
 #endif
 
+#if defined(PREDECODE_SEQUENCES) && !(defined(VERSION_US) || defined(VERSION_JP))
+    #undef PREDECODE_SEQUENCES
+#endif
+
 /*****************
  * config_debug.h
  */
@@ -69,6 +73,8 @@
     #undef VANILLA_DEBUG
     #undef DEBUG_FORCE_CRASH_ON_BOOT
     #undef DEBUG_ASSERTIONS
+    #undef EVENT_TRACER
+    #undef BEHAVIOR_PROFILER
 #endif // DISABLE_ALL
 
 #ifdef DEBUG_ALL
@@ -105,6 +111,8 @@
     #define PUPPYPRINT
     #undef USE_PROFILER
     #define USE_PROFILER
+#else
+    #undef BEHAVIOR_PROFILER
 #endif // PUPPYPRINT_DEBUG
 
 #ifdef COMPLETE_SAVE_FILE
@@ -117,6 +125,11 @@
     #define DEBUG_ASSERTIONS
 #endif // DEBUG
 
+// The audio quality governor is driven by the profiler's audio timings.
+#ifndef USE_PROFILER
+    #undef AUDIO_QUALITY_GOVERNOR
+#endif // !USE_PROFILER
+
 
 /*****************
  * config_camera.h
@@ -200,3 +213,19 @@
     #undef BORDER_HEIGHT_EMULATOR
     #define BORDER_HEIGHT_EMULATOR 0
 #endif // !TARGET_N64
+
+// Segments are only decompressed into RAM when segmented memory is in use.
+#ifdef NO_SEGMENTED_MEMORY
+    #undef SEGMENT_CACHE
+    #undef STREAM_LEVEL_SEGMENTS
+#endif // NO_SEGMENTED_MEMORY
+
+// There is nothing to stream when segments aren't compressed.
+#ifdef UNCOMPRESSED
+    #undef STREAM_LEVEL_SEGMENTS
+#endif // UNCOMPRESSED
+
+// EU keeps the dialog text in its translation segments.
+#ifdef VERSION_EU
+    #undef ROM_RESIDENT_DIALOG
+#endif // VERSION_EU
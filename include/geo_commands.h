@@ -58,6 +58,9 @@ enum GeoLayoutCommands {
     /*0x1E*/ GEO_CMD_NOP_1E,
     /*0x1F*/ GEO_CMD_NOP_1F,
     /*0x20*/ GEO_CMD_NODE_CULLING_RADIUS,
+    /*0x21*/ GEO_CMD_NODE_CULLING_BOUNDS,
+    /*0x22*/ GEO_CMD_NODE_ROOM,
+    /*0x23*/ GEO_CMD_ROOM_PORTAL,
 
     GEO_CMD_COUNT,
 };
@@ -488,4 +491,46 @@ enum GeoLayoutCommands {
 #define GEO_CULLING_RADIUS(cullingRadius) \
     CMD_BBH(GEO_CMD_NODE_CULLING_RADIUS, 0x00, cullingRadius)
 
+/**
+ * 0x21: Create a scene graph node that only renders its children when the
+ * given bounding box is in view. Used to split level geometry into chunks.
+ *   0x01: unused
+ *   0x02: unused
+ *   0x04: s16 minX, minY, minZ
+ *   0x0A: s16 maxX, maxY, maxZ
+ */
+#define GEO_CULLING_BOUNDS(minX, minY, minZ, maxX, maxY, maxZ) \
+    CMD_BBH(GEO_CMD_NODE_CULLING_BOUNDS, 0x00, 0x0000), \
+    CMD_HH(minX, minY), \
+    CMD_HH(minZ, maxX), \
+    CMD_HH(maxY, maxZ)
+
+/**
+ * Draws an area display list that tools/split_area_dl.py split into chunks,
+ * each in its own GEO_CULLING_BOUNDS node. The model's generated .chunks.h has to be included.
+ */
+#define GEO_CHUNKED_DISPLAY_LIST(layer, displayList) \
+    GEO_CHUNKS_##displayList(layer)
+
+/**
+ * 0x22: Create a scene graph node that only renders its children while
+ * the given room is visible from the camera's room.
+ *   0x01: unused
+ *   0x02: s16 room
+ */
+#define GEO_ROOM(room) \
+    CMD_BBH(GEO_CMD_NODE_ROOM, 0x00, room)
+
+/**
+ * 0x23: Declare that two rooms can be seen into from each other, for openings without a door.
+ * Doesn't create a node. Only use this in area geo layouts.
+ *   0x01: unused
+ *   0x02: s16 roomA
+ *   0x04: s16 roomB
+ *   0x06: unused
+ */
+#define GEO_ROOM_PORTAL(roomA, roomB) \
+    CMD_BBH(GEO_CMD_ROOM_PORTAL, 0x00, roomA), \
+    CMD_HH(roomB, 0x0000)
+
 #endif // GEO_COMMANDS_H
@@ -46,6 +46,16 @@ DECLARE_SEGMENT(entry)
 DECLARE_SEGMENT(engine)
 DECLARE_SEGMENT(behavior)
 DECLARE_NOLOAD(behavior)
+
+#ifdef BEHAVIOR_OVERLAYS
+DECLARE_SEGMENT(ttc_overlay)
+DECLARE_NOLOAD(ttc_overlay)
+#endif
+
+#ifdef ROM_RESIDENT_DIALOG
+DECLARE_SEGMENT(dialog_text)
+#endif
+
 DECLARE_SEGMENT(scripts)
 DECLARE_SEGMENT(goddard)
 DECLARE_SEGMENT(framebuffers)
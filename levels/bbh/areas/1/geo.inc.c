@@ -481,6 +481,9 @@ const GeoLayout geo_bbh_000F00[] = {
          GEO_OPEN_NODE(),
             GEO_CAMERA(CAMERA_MODE_CLOSE, 0, 2000, 6000, 0, 0, 0, geo_camera_main),
             GEO_OPEN_NODE(),
+               // Rooms 3 and 6 share one open space, so they're always visible from each other.
+               // Every other opening has a door, which already connects the rooms on either side.
+               GEO_ROOM_PORTAL(3, 6),
                GEO_SWITCH_CASE(32, geo_switch_area),
                GEO_OPEN_NODE(),
                   GEO_BRANCH(1, geo_bbh_000670), // 0x0E000670
@@ -39,6 +39,9 @@ const LevelScript level_ttc_entry[] = {
     LOAD_RAW(         /*seg*/ 0x0C, _group1_geoSegmentRomStart,  _group1_geoSegmentRomEnd),
     LOAD_YAY0(        /*seg*/ 0x08, _common0_yay0SegmentRomStart, _common0_yay0SegmentRomEnd),
     LOAD_RAW(         /*seg*/ 0x0F, _common0_geoSegmentRomStart,  _common0_geoSegmentRomEnd),
+#ifdef BEHAVIOR_OVERLAYS
+    LOAD_RAW_WITH_CODE(SEGMENT_BEHAVIOR_OVERLAY, _ttc_overlaySegmentRomStart, _ttc_overlaySegmentRomEnd, _ttc_overlaySegmentBssStart, _ttc_overlaySegmentBssEnd),
+#endif
     ALLOC_LEVEL_POOL(),
     MARIO(/*model*/ MODEL_MARIO, /*behParam*/ 0x00000001, /*beh*/ bhvMario),
     JUMP_LINK(script_func_global_1),
@@ -15,8 +15,8 @@ const GeoLayout wdw_geo_000658[] = {
          GEO_OPEN_NODE(),
             GEO_CAMERA(CAMERA_MODE_RADIAL, 0, 2000, 6000, -4352, 0, -4352, geo_camera_main),
             GEO_OPEN_NODE(),
-               GEO_DISPLAY_LIST(LAYER_OPAQUE,            wdw_seg7_dl_07009AB0),
-               GEO_DISPLAY_LIST(LAYER_ALPHA,             wdw_seg7_dl_0700A138),
+               GEO_CHUNKED_DISPLAY_LIST(LAYER_OPAQUE,    wdw_seg7_dl_07009AB0),
+               GEO_CHUNKED_DISPLAY_LIST(LAYER_ALPHA,     wdw_seg7_dl_0700A138),
                GEO_DISPLAY_LIST(LAYER_TRANSPARENT,       wdw_seg7_dl_07012798),
                GEO_DISPLAY_LIST(LAYER_TRANSPARENT_DECAL, wdw_seg7_dl_07012908),
                GEO_ASM(0,                      geo_wdw_set_initial_water_level),
@@ -12,6 +12,8 @@
 #include "make_const_nonconst.h"
 
 #include "levels/wdw/header.h"
+#include "levels/wdw/areas/1/1/model.chunks.h"
+#include "levels/wdw/areas/1/2/model.chunks.h"
 
 #include "levels/wdw/square_floating_platform/geo.inc.c"
 #include "levels/wdw/arrow_lift/geo.inc.c"
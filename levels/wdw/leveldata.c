@@ -10,8 +10,8 @@
 
 #include "make_const_nonconst.h"
 #include "levels/wdw/texture.inc.c"
-#include "levels/wdw/areas/1/1/model.inc.c"
-#include "levels/wdw/areas/1/2/model.inc.c"
+#include "levels/wdw/areas/1/1/model.chunks.inc.c"
+#include "levels/wdw/areas/1/2/model.chunks.inc.c"
 #include "levels/wdw/areas/2/1/model.inc.c"
 #include "levels/wdw/areas/2/2/model.inc.c"
 #include "levels/wdw/areas/1/3/model.inc.c"
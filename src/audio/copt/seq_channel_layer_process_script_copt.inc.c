@@ -8,6 +8,7 @@
 #include "audio/data.h"
 #include "audio/load.h"
 #include "audio/seqplayer.h"
+#include "audio/seq_predecode.h"
 #include "audio/external.h"
 #include "audio/effects.h"
 
@@ -156,6 +157,23 @@ void seq_channel_layer_process_script(struct SequenceChannelLayer *layer) {
 
     struct SequenceChannel *seqChannel = (*layer).seqChannel;
     struct SequencePlayer  *seqPlayer = (*seqChannel).seqPlayer;
+#ifdef PREDECODE_SEQUENCES
+    if (layer->decodedOp != NULL) {
+        s32 decoded = seq_layer_process_decoded_ops(layer, &sp3A);
+
+        if (decoded == PREDECODE_LAYER_DISABLED) {
+            return;
+        }
+        if (decoded == PREDECODE_LAYER_DELAY) {
+            goto decoded_delay;
+        }
+        if (decoded != PREDECODE_LAYER_FALLBACK) {
+            cmdSemitone = decoded;
+            goto decoded_note;
+        }
+        // Otherwise the rest of the script runs from the bytecode.
+    }
+#endif
     for (;;) {
         state = &layer->scriptState;
         //M64_READ_U8(state, cmd);
@@ -334,6 +352,9 @@ l1138:
             cmdSemitone = cmd - (cmd & 0xc0);
         }
 
+#ifdef PREDECODE_SEQUENCES
+decoded_note:
+#endif
         layer->delay = sp3A;
         layer->duration = layer->noteDuration * sp3A / 256;
         if ((seqPlayer->muted && (seqChannel->muteBehavior & MUTE_BEHAVIOR_STOP_NOTES) != 0)
@@ -443,6 +464,9 @@ l13cc:
         }
     }
 
+#ifdef PREDECODE_SEQUENCES
+decoded_delay:
+#endif
     if (layer->stopSomething == TRUE) {
         if (layer->note != NULL || layer->continuousNotes) {
             seq_channel_layer_note_decay(layer);
@@ -49,7 +49,8 @@ struct SoundCharacteristics {
     u8 freshness;
     u8 prev;
     u8 next;
-}; // size = 0x1C
+    u8 sourceNext; // next sound in the same sSoundSources bucket
+}; // size = 0x20
 
 // Also the number of frames a discrete sound can be in the WAITING state before being deleted
 #define SOUND_MAX_FRESHNESS 10
@@ -359,6 +360,15 @@ u8 sCurrentSound[SOUND_BANK_COUNT][MAX_CHANNELS_PER_SOUND_BANK]; // index into s
  */
 struct SoundCharacteristics sSoundBanks[SOUND_BANK_COUNT][40];
 
+/**
+ * For each sound bank, a hash table from a sound's source position pointer to the sounds in the
+ * used list with that source, chained through sourceNext. A bank never holds more than one sound
+ * from the same source, so this finds it without walking the used list.
+ */
+#define SOUND_SOURCE_HASH_BITS 4
+#define SOUND_SOURCE_HASH_SIZE (1 << SOUND_SOURCE_HASH_BITS)
+u8 sSoundSources[SOUND_BANK_COUNT][SOUND_SOURCE_HASH_SIZE];
+
 u8 sSoundMovingSpeed[SOUND_BANK_COUNT];
 u8 sBackgroundMusicTargetVolume;
 static u8 sLowerBackgroundMusicVolume;
@@ -704,64 +714,94 @@ void play_sound(s32 soundBits, f32 *pos) {
     sSoundRequestCount++;
 }
 
+static u8 *get_sound_source_bucket(u8 bank, f32 *pos) {
+    return &sSoundSources[bank][(((uintptr_t) pos >> 2) * 2654435761U) >> (32 - SOUND_SOURCE_HASH_BITS)];
+}
+
+/**
+ * Returns the index of the sound in the bank's used list with the given source, or 0xff if there isn't one.
+ */
+static u8 find_sound_from_source(u8 bank, f32 *pos) {
+    u8 soundIndex = *get_sound_source_bucket(bank, pos);
+
+    while (soundIndex != 0xff && sSoundBanks[bank][soundIndex].x != pos) {
+        soundIndex = sSoundBanks[bank][soundIndex].sourceNext;
+    }
+
+    return soundIndex;
+}
+
+static void add_sound_source(u8 bank, u8 soundIndex) {
+    u8 *bucket = get_sound_source_bucket(bank, sSoundBanks[bank][soundIndex].x);
+
+    sSoundBanks[bank][soundIndex].sourceNext = *bucket;
+    *bucket = soundIndex;
+}
+
+static void remove_sound_source(u8 bank, u8 soundIndex) {
+    u8 *link = get_sound_source_bucket(bank, sSoundBanks[bank][soundIndex].x);
+
+    while (*link != 0xff) {
+        if (*link == soundIndex) {
+            *link = sSoundBanks[bank][soundIndex].sourceNext;
+            return;
+        }
+        link = &sSoundBanks[bank][*link].sourceNext;
+    }
+}
+
 /**
  * Called from threads: thread4_sound, thread5_game_loop (EU only)
  */
 static void process_sound_request(u32 bits, f32 *pos) {
-    s32 counter = 0;
-
     s32 bank = (bits & SOUNDARGS_MASK_BANK) >> SOUNDARGS_SHIFT_BANK;
 
     if (sSoundBankDisabled[bank]) {
         return;
     }
 
-    s32 soundIndex = sSoundBanks[bank][0].next;
-    while (soundIndex != 0xff && soundIndex != 0) {
-        // If an existing sound from the same source exists in the bank, then we should either
-        // interrupt that sound and replace it with the new sound, or we should drop the new sound.
-        if (sSoundBanks[bank][soundIndex].x == pos) {
-            // If the existing sound has lower or equal priority, then we should replace it.
-            // Otherwise the new sound will be dropped.
-            if ((sSoundBanks[bank][soundIndex].soundBits & SOUNDARGS_MASK_PRIORITY)
-                <= (bits & SOUNDARGS_MASK_PRIORITY)) {
-
-                // If the existing sound is discrete or is a different continuous sound, then
-                // interrupt it and play the new sound instead.
-                // Otherwise the new sound is continuous and equals the existing sound, so we just
-                // need to update the sound's freshness.
-                if ((sSoundBanks[bank][soundIndex].soundBits & SOUND_DISCRETE) != 0
-                    || (bits & SOUNDARGS_MASK_SOUNDID)
-                           != (sSoundBanks[bank][soundIndex].soundBits & SOUNDARGS_MASK_SOUNDID)) {
-                    update_background_music_after_sound(bank, soundIndex);
-                    sSoundBanks[bank][soundIndex].soundBits = bits;
-                    // In practice, the starting status is always WAITING
-                    sSoundBanks[bank][soundIndex].soundStatus = bits & SOUNDARGS_MASK_STATUS;
-                }
+    if (sSoundBanks[bank][0].next == 0xff) {
+        sSoundMovingSpeed[bank] = 32;
+    }
 
-                // Reset freshness:
-                // - For discrete sounds, this gives the sound SOUND_MAX_FRESHNESS frames to play
-                //   before it gets deleted for being stale
-                // - For continuous sounds, this gives it another 2 frames before play_sound must
-                //   be called again to keep it playing
-                sSoundBanks[bank][soundIndex].freshness = SOUND_MAX_FRESHNESS;
+    s32 soundIndex = find_sound_from_source(bank, pos);
+
+    // If an existing sound from the same source exists in the bank, then we should either
+    // interrupt that sound and replace it with the new sound, or we should drop the new sound.
+    if (soundIndex != 0xff) {
+        // If the existing sound has lower or equal priority, then we should replace it.
+        // Otherwise the new sound will be dropped.
+        if ((sSoundBanks[bank][soundIndex].soundBits & SOUNDARGS_MASK_PRIORITY)
+            <= (bits & SOUNDARGS_MASK_PRIORITY)) {
+
+            // If the existing sound is discrete or is a different continuous sound, then
+            // interrupt it and play the new sound instead.
+            // Otherwise the new sound is continuous and equals the existing sound, so we just
+            // need to update the sound's freshness.
+            if ((sSoundBanks[bank][soundIndex].soundBits & SOUND_DISCRETE) != 0
+                || (bits & SOUNDARGS_MASK_SOUNDID)
+                       != (sSoundBanks[bank][soundIndex].soundBits & SOUNDARGS_MASK_SOUNDID)) {
+                update_background_music_after_sound(bank, soundIndex);
+                sSoundBanks[bank][soundIndex].soundBits = bits;
+                // In practice, the starting status is always WAITING
+                sSoundBanks[bank][soundIndex].soundStatus = bits & SOUNDARGS_MASK_STATUS;
             }
 
-            // Prevent allocating a new node - if the existing sound had higher piority, then the
-            // new sound will be dropped
-            soundIndex = 0;
-        } else {
-            soundIndex = sSoundBanks[bank][soundIndex].next;
+            // Reset freshness:
+            // - For discrete sounds, this gives the sound SOUND_MAX_FRESHNESS frames to play
+            //   before it gets deleted for being stale
+            // - For continuous sounds, this gives it another 2 frames before play_sound must
+            //   be called again to keep it playing
+            sSoundBanks[bank][soundIndex].freshness = SOUND_MAX_FRESHNESS;
         }
-        counter++;
-    }
 
-    if (counter == 0) {
-        sSoundMovingSpeed[bank] = 32;
+        // Don't allocate a new node - if the existing sound had higher piority, then the
+        // new sound is dropped
+        return;
     }
 
     // If free list has more than one element remaining
-    if (sSoundBanks[bank][sSoundBankFreeListFront[bank]].next != 0xff && soundIndex != 0) {
+    if (sSoundBanks[bank][sSoundBankFreeListFront[bank]].next != 0xff) {
         // Allocate from free list
         soundIndex = sSoundBankFreeListFront[bank];
 
@@ -782,6 +822,8 @@ static void process_sound_request(u32 bits, f32 *pos) {
         sSoundBankFreeListFront[bank] = sSoundBanks[bank][sSoundBankFreeListFront[bank]].next;
         sSoundBanks[bank][sSoundBankFreeListFront[bank]].prev = 0xff;
         sSoundBanks[bank][soundIndex].next = 0xff;
+
+        add_sound_source(bank, soundIndex);
     }
 }
 
@@ -804,6 +846,8 @@ static void process_all_sound_requests(void) {
  * Called from threads: thread4_sound, thread5_game_loop (EU only)
  */
 static void delete_sound_from_bank(u8 bank, u8 soundIndex) {
+    remove_sound_source(bank, soundIndex);
+
     if (sSoundBankUsedListBack[bank] == soundIndex) {
         // Remove from end of used list
         sSoundBankUsedListBack[bank] = sSoundBanks[bank][soundIndex].prev;
@@ -1955,6 +1999,11 @@ void sound_init(void) {
         sSoundBankUsedListBack[i] = 0;
         sSoundBankFreeListFront[i] = 1;
         sNumSoundsInBank[i] = 0;
+
+        // Clear the source lookup
+        for (j = 0; j < SOUND_SOURCE_HASH_SIZE; j++) {
+            sSoundSources[i][j] = 0xff;
+        }
     }
 
     for (i = 0; i < SOUND_BANK_COUNT; i++) {
@@ -2021,21 +2070,15 @@ void get_currently_playing_sound(u8 bank, u8 *numPlayingSounds, u8 *numSoundsInB
  */
 void stop_sound(u32 soundBits, f32 *pos) {
     u8 bank = (soundBits & SOUNDARGS_MASK_BANK) >> SOUNDARGS_SHIFT_BANK;
-    u8 soundIndex = sSoundBanks[bank][0].next;
-
-    while (soundIndex != 0xff) {
-        // If sound has same id and source position pointer
-        if ((u16)(soundBits >> SOUNDARGS_SHIFT_SOUNDID)
-                == (u16)(sSoundBanks[bank][soundIndex].soundBits >> SOUNDARGS_SHIFT_SOUNDID)
-            && sSoundBanks[bank][soundIndex].x == pos) {
+    u8 soundIndex = find_sound_from_source(bank, pos);
 
-            // Mark sound for deletion
-            update_background_music_after_sound(bank, soundIndex);
-            sSoundBanks[bank][soundIndex].soundBits = NO_SOUND;
-            soundIndex = 0xff; // break
-        } else {
-            soundIndex = sSoundBanks[bank][soundIndex].next;
-        }
+    // If sound has same id and source position pointer
+    if (soundIndex != 0xff
+        && (u16)(soundBits >> SOUNDARGS_SHIFT_SOUNDID)
+               == (u16)(sSoundBanks[bank][soundIndex].soundBits >> SOUNDARGS_SHIFT_SOUNDID)) {
+        // Mark sound for deletion
+        update_background_music_after_sound(bank, soundIndex);
+        sSoundBanks[bank][soundIndex].soundBits = NO_SOUND;
     }
 }
 
@@ -2047,13 +2090,10 @@ void stop_sounds_from_source(f32 *pos) {
     u8 soundIndex;
 
     for (bank = 0; bank < SOUND_BANK_COUNT; bank++) {
-        soundIndex = sSoundBanks[bank][0].next;
-        while (soundIndex != 0xff) {
-            if (sSoundBanks[bank][soundIndex].x == pos) {
-                update_background_music_after_sound(bank, soundIndex);
-                sSoundBanks[bank][soundIndex].soundBits = NO_SOUND;
-            }
-            soundIndex = sSoundBanks[bank][soundIndex].next;
+        soundIndex = find_sound_from_source(bank, pos);
+        if (soundIndex != 0xff) {
+            update_background_music_after_sound(bank, soundIndex);
+            sSoundBanks[bank][soundIndex].soundBits = NO_SOUND;
         }
     }
 }
@@ -0,0 +1,91 @@
+#include <ultra64.h>
+
+#include "governor.h"
+#include "load.h"
+#include "game/profiling.h"
+
+#ifdef AUDIO_QUALITY_GOVERNOR
+
+// The number of notes allowed to play at once on each level, in eighths of gMaxSimultaneousNotes.
+static const u8 sGovernorNoteLimits[AUDIO_GOVERNOR_LEVEL_COUNT] = { 8, 7, 6, 5 };
+
+// How many more times the reverb is downsampled on each level. Only applied on the next audio_reset_session.
+static const u8 sGovernorReverbDownsampleShifts[AUDIO_GOVERNOR_LEVEL_COUNT] = { 0, 0, 1, 2 };
+
+static s32 sGovernorLevel = AUDIO_GOVERNOR_LEVEL_FULL;
+static s32 sGovernorOverFrames = 0;
+static s32 sGovernorUnderFrames = 0;
+// Wait until the profiler's averages only cover updates made at the current level before judging it.
+static s32 sGovernorHoldFrames = PROFILING_BUFFER_SIZE;
+
+static s32 sGovernorNoteLimit = MAX_SIMULTANEOUS_NOTES;
+static s32 sGovernorActiveNotes = 0;
+
+static void audio_governor_set_level(s32 level) {
+    sGovernorLevel = level;
+    sGovernorOverFrames = 0;
+    sGovernorUnderFrames = 0;
+    sGovernorHoldFrames = PROFILING_BUFFER_SIZE;
+}
+
+/**
+ * Called from the audio thread after every audio update, so nothing here races with note allocation.
+ */
+void audio_governor_update(void) {
+    u32 cpuUs = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_AUDIO].total / PROFILING_BUFFER_SIZE);
+    u32 rspUs = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_RSP_AUDIO].total / PROFILING_BUFFER_SIZE);
+    s32 i;
+
+    if (sGovernorHoldFrames > 0) {
+        sGovernorHoldFrames--;
+    } else if (cpuUs > AUDIO_GOVERNOR_CPU_BUDGET || rspUs > AUDIO_GOVERNOR_RSP_BUDGET) {
+        sGovernorUnderFrames = 0;
+        if (++sGovernorOverFrames >= AUDIO_GOVERNOR_DOWN_FRAMES && sGovernorLevel < (AUDIO_GOVERNOR_LEVEL_COUNT - 1)) {
+            audio_governor_set_level(sGovernorLevel + 1);
+        }
+    } else if (cpuUs < (AUDIO_GOVERNOR_CPU_BUDGET * 3 / 4) && rspUs < (AUDIO_GOVERNOR_RSP_BUDGET * 3 / 4)) {
+        sGovernorOverFrames = 0;
+        if (++sGovernorUnderFrames >= AUDIO_GOVERNOR_UP_FRAMES && sGovernorLevel > AUDIO_GOVERNOR_LEVEL_FULL) {
+            audio_governor_set_level(sGovernorLevel - 1);
+        }
+    } else {
+        sGovernorOverFrames = 0;
+        sGovernorUnderFrames = 0;
+    }
+
+    sGovernorNoteLimit = ((gMaxSimultaneousNotes * sGovernorNoteLimits[sGovernorLevel]) / 8);
+
+    // Recount the playing notes, since nothing tells the governor when one finishes.
+    sGovernorActiveNotes = 0;
+    for (i = 0; i < gMaxSimultaneousNotes; i++) {
+#if defined(VERSION_EU) || defined(VERSION_SH)
+        if (gNotes[i].noteSubEu.enabled) {
+#else
+        if (gNotes[i].enabled) {
+#endif
+            sGovernorActiveNotes++;
+        }
+    }
+}
+
+s32 audio_governor_get_level(void) {
+    return sGovernorLevel;
+}
+
+/**
+ * Whether a new note has to steal from a playing one instead of starting a free one. Stolen notes are released
+ * with their usual envelopes, so lowering the limit doesn't cut anything off abruptly.
+ */
+s32 audio_governor_note_limit_reached(void) {
+    return (sGovernorActiveNotes >= sGovernorNoteLimit);
+}
+
+void audio_governor_note_allocated(void) {
+    sGovernorActiveNotes++;
+}
+
+s32 audio_governor_get_reverb_downsample_shift(void) {
+    return sGovernorReverbDownsampleShifts[sGovernorLevel];
+}
+
+#endif // AUDIO_QUALITY_GOVERNOR
@@ -0,0 +1,38 @@
+#ifndef AUDIO_GOVERNOR_H
+#define AUDIO_GOVERNOR_H
+
+#include <PR/ultratypes.h>
+
+#include "internal.h"
+
+/**
+ * Quality levels of the audio quality governor, from full quality to the cheapest settings.
+ */
+enum AudioGovernorLevels {
+    AUDIO_GOVERNOR_LEVEL_FULL,
+    AUDIO_GOVERNOR_LEVEL_FEWER_NOTES,
+    AUDIO_GOVERNOR_LEVEL_REDUCED_REVERB,
+    AUDIO_GOVERNOR_LEVEL_MINIMUM,
+    AUDIO_GOVERNOR_LEVEL_COUNT
+};
+
+// How many audio updates in a row have to be over budget before the quality is lowered.
+#define AUDIO_GOVERNOR_DOWN_FRAMES 30
+// How many audio updates in a row have to be well under budget before the quality is raised again.
+#define AUDIO_GOVERNOR_UP_FRAMES 300
+
+#ifdef AUDIO_QUALITY_GOVERNOR
+void audio_governor_update(void);
+s32 audio_governor_get_level(void);
+s32 audio_governor_note_limit_reached(void);
+void audio_governor_note_allocated(void);
+s32 audio_governor_get_reverb_downsample_shift(void);
+#else
+#define audio_governor_update()
+#define audio_governor_get_level() AUDIO_GOVERNOR_LEVEL_FULL
+#define audio_governor_note_limit_reached() FALSE
+#define audio_governor_note_allocated()
+#define audio_governor_get_reverb_downsample_shift() 0
+#endif
+
+#endif // AUDIO_GOVERNOR_H
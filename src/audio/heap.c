@@ -6,6 +6,7 @@
 #include "synthesis.h"
 #include "seqplayer.h"
 #include "effects.h"
+#include "governor.h"
 #include "game/emutest.h"
 #include "game/puppyprint.h"
 #include "game/debug.h"
@@ -1046,6 +1047,13 @@ void init_reverb_us(s32 presetId) {
 
     s32 reverbWindowSize = gReverbSettings[presetId].windowSize;
     gReverbDownsampleRate = gReverbSettings[presetId].downsampleRate;
+#ifdef AUDIO_QUALITY_GOVERNOR
+    // Downsample further when the governor asks for it, keeping the same delay with a smaller window.
+    for (i = audio_governor_get_reverb_downsample_shift(); i > 0 && gReverbDownsampleRate < 4; i--) {
+        gReverbDownsampleRate *= 2;
+        reverbWindowSize = ALIGN16(reverbWindowSize / 2);
+    }
+#endif
 #ifdef BETTER_REVERB
     struct BetterReverbSettings *betterReverbPreset = &gBetterReverbSettings[gBetterReverbPresetValue];
 
@@ -1065,6 +1073,11 @@ void init_reverb_us(s32 presetId) {
     activeBetterReverbPreset = gBetterReverbPresetValue;
     betterReverbLightweight = betterReverbPreset->useLightweightSettings;
     betterReverbDownsampleRate = betterReverbPreset->downsampleRate;
+#ifdef AUDIO_QUALITY_GOVERNOR
+    for (i = audio_governor_get_reverb_downsample_shift(); i > 0 && betterReverbDownsampleRate > 0 && betterReverbDownsampleRate < 3; i--) {
+        betterReverbDownsampleRate++;
+    }
+#endif
     monoReverb = betterReverbPreset->isMono;
     reverbFilterCount = betterReverbPreset->filterCount;
     betterReverbWindowsSize = betterReverbPreset->windowSize;
@@ -249,6 +249,18 @@ struct M64ScriptState {
     u8 depth;
 }; // size = 0x1C
 
+#ifdef PREDECODE_SEQUENCES
+// A layer script command decoded by seq_predecode.c.
+struct M64LayerOp {
+    u8 cmd;     // the command byte, including the semitone of notes
+    u8 flags;   // M64LayerOpFlags
+    u8 arg;     // first u8 argument (velocity, loop count, instrument, portamento mode, ...)
+    u8 arg2;    // second u8 argument (note duration, portamento note, ...)
+    u16 value;  // compressed u16 argument, or the index of the op a jump or call goes to
+    u16 offset; // where the command starts in the sequence
+}; // size = 0x8
+#endif
+
 // Also known as a Group, according to debug strings.
 struct SequencePlayer {
     /*US/JP, EU,    SH   */
@@ -554,6 +566,10 @@ struct SequenceChannelLayer {
 #if defined(VERSION_EU)
     u8 pad2[4];
 #endif
+#ifdef PREDECODE_SEQUENCES
+    struct M64LayerOp *decodedOp; // next op to run, or NULL if the script runs from scriptState.pc
+    struct M64LayerOp *decodedStack[4];
+#endif
 }; // size = 0x80
 
 #if defined(VERSION_EU) || defined(VERSION_SH)
@@ -7,6 +7,7 @@
 #include "heap.h"
 #include "load.h"
 #include "seqplayer.h"
+#include "seq_predecode.h"
 #include "game/puppyprint.h"
 
 struct SharedDma {
@@ -753,6 +754,7 @@ void load_sequence_internal(u32 player, u32 seqId, s32 loadAsync) {
     seqPlayer->enabled = TRUE;
     seqPlayer->seqData = sequenceData;
     seqPlayer->scriptState.pc = sequenceData;
+    seq_predecode_reset(player, seqId);
 }
 
 // (void) must be omitted from parameters to fix stack with -framepointer
@@ -8,6 +8,7 @@
 #include "synthesis.h"
 #include "effects.h"
 #include "external.h"
+#include "governor.h"
 
 void note_set_resampling_rate(struct Note *note, f32 resamplingRateInput);
 
@@ -1188,6 +1189,10 @@ void note_release_and_take_ownership(struct Note *note, struct SequenceChannelLa
 }
 
 struct Note *alloc_note_from_disabled(struct NotePool *pool, struct SequenceChannelLayer *seqLayer) {
+    if (audio_governor_note_limit_reached()) {
+        return NULL;
+    }
+
     struct Note *note = audio_list_pop_back(&pool->disabled);
     if (note != NULL) {
 #if defined(VERSION_EU) || defined(VERSION_SH)
@@ -1199,6 +1204,7 @@ struct Note *alloc_note_from_disabled(struct NotePool *pool, struct SequenceChan
         }
 #endif
         audio_list_push_front(&pool->active, &note->listItem);
+        audio_governor_note_allocated();
     }
     return note;
 }
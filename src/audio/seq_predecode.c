@@ -0,0 +1,498 @@
+#include <ultra64.h>
+
+#include "seq_predecode.h"
+#include "load.h"
+#include "playback.h"
+#include "seqplayer.h"
+
+#ifdef PREDECODE_SEQUENCES
+
+#define PREDECODE_MAX_RUNS 128
+
+/**
+ * A stretch of the sequence decoded in one go, from the start of a layer script or a jump or call target
+ * to the first layer_end or layer_jump after it. Its ops are contiguous and sorted by offset.
+ */
+struct SeqPredecodeRun {
+    u16 start;
+    u16 end;
+    u16 firstOp;
+    u16 numOps;
+    u8 largeNotes;
+};
+
+struct SeqPredecodeState {
+    struct M64LayerOp ops[PREDECODE_SEQUENCES_MAX_OPS];
+    struct SeqPredecodeRun runs[PREDECODE_MAX_RUNS];
+    u16 numOps;
+    u16 numRuns;
+    u16 seqLength;
+    u8 disabled; // set when the sequence writes over a decoded script
+};
+
+static struct SeqPredecodeState sSeqPredecode[SEQUENCE_PLAYERS];
+
+static struct SeqPredecodeState *get_predecode_state(struct SequencePlayer *seqPlayer) {
+    return &sSeqPredecode[seqPlayer - gSequencePlayers];
+}
+
+/**
+ * Called whenever a sequence player loads a sequence, which throws away everything decoded for the last one.
+ */
+void seq_predecode_reset(u32 player, u32 seqId) {
+    struct SeqPredecodeState *state = &sSeqPredecode[player];
+    u32 seqLength = gSeqFileHeader->seqArray[seqId].len;
+
+    state->numOps = 0;
+    state->numRuns = 0;
+    state->seqLength = (seqLength > 0xFFFF) ? 0xFFFF : seqLength;
+    state->disabled = FALSE;
+}
+
+/**
+ * Find the op decoded for the command at offset, or -1 if it hasn't been decoded with the given note length.
+ */
+static s32 find_decoded_op(struct SeqPredecodeState *state, u16 offset, u8 largeNotes) {
+    struct SeqPredecodeRun *run = state->runs;
+    s32 i;
+
+    for (i = 0; i < state->numRuns; i++, run++) {
+        if (run->largeNotes != largeNotes || offset < run->start || offset >= run->end) {
+            continue;
+        }
+
+        s32 lo = run->firstOp;
+        s32 hi = (run->firstOp + run->numOps - 1);
+        while (lo <= hi) {
+            s32 mid = ((lo + hi) >> 1);
+            struct M64LayerOp *op = &state->ops[mid];
+
+            if (op->offset == offset) {
+                if (!(op->flags & M64_OP_FALLBACK)) {
+                    return mid;
+                }
+                break;
+            }
+            if (op->offset < offset) {
+                lo = (mid + 1);
+            } else {
+                hi = (mid - 1);
+            }
+        }
+    }
+
+    return -1;
+}
+
+static u16 predecode_read_compressed_u16(u8 **pc) {
+    u16 ret = *((*pc)++);
+    if (ret & 0x80) {
+        ret = (ret << 8) & 0x7f00;
+        ret = *((*pc)++) | ret;
+    }
+    return ret;
+}
+
+/**
+ * Decode commands starting at offset until the script ends or jumps away, or until the ops run out, in which case the
+ * run ends with a fallback op. Jump and call targets are left as offsets for seq_predecode_layer to resolve.
+ * Returns the index of the first op, or -1 if there's no room for a new run.
+ */
+static s32 decode_run(struct SeqPredecodeState *state, u8 *seqData, u16 offset, u8 largeNotes) {
+    struct SeqPredecodeRun *run;
+    struct M64LayerOp *op;
+    u8 *pc;
+    u8 done = FALSE;
+
+    if (state->numRuns >= PREDECODE_MAX_RUNS || (state->numOps + 2) > PREDECODE_SEQUENCES_MAX_OPS) {
+        return -1;
+    }
+
+    run = &state->runs[state->numRuns++];
+    run->start = offset;
+    run->firstOp = state->numOps;
+    run->largeNotes = largeNotes;
+
+    while (!done) {
+        op = &state->ops[state->numOps++];
+        op->offset = offset;
+        op->flags = (largeNotes ? M64_OP_LARGE_NOTES : 0);
+        op->arg = 0;
+        op->arg2 = 0;
+        op->value = 0;
+
+        // Keep the last op free for the fallback, and leave anything outside the sequence to the bytecode.
+        if (state->numOps == PREDECODE_SEQUENCES_MAX_OPS || offset >= state->seqLength) {
+            op->cmd = 0xff;
+            op->flags |= M64_OP_FALLBACK;
+            break;
+        }
+
+        pc = (seqData + offset);
+        op->cmd = *pc++;
+
+        switch (op->cmd) {
+            case 0xff: // layer_end
+                done = TRUE;
+                break;
+
+            case 0xfb: // layer_jump
+                done = TRUE;
+                // fallthrough
+            case 0xfc: // layer_call
+                op->value = ((pc[0] << 8) | pc[1]);
+                op->flags |= M64_OP_TARGET_OFFSET;
+                pc += 2;
+                break;
+
+            case 0xf8: // layer_loop
+            case 0xc1: // layer_setshortnotevelocity
+            case 0xca: // layer_setpan
+            case 0xc2: // layer_transpose
+            case 0xc9: // layer_setshortnoteduration
+            case 0xc6: // layer_setinstr
+                op->arg = *pc++;
+                break;
+
+            case 0xc3: // layer_setshortnotedefaultplaypercentage
+            case 0xc0: // layer_delay
+                op->value = predecode_read_compressed_u16(&pc);
+                break;
+
+            case 0xc7: // layer_portamento
+                op->arg = *pc++;
+                op->arg2 = *pc++;
+                if (op->arg & 0x80) {
+                    op->value = *pc++;
+                } else {
+                    op->value = predecode_read_compressed_u16(&pc);
+                }
+                break;
+
+            default:
+                if (op->cmd > 0xc0) {
+                    // layer_loopend, layer_somethingon/off, layer_disableportamento and the table commands have no arguments.
+                    break;
+                }
+
+                switch (op->cmd & 0xc0) {
+                    case 0x00: // layer_note0
+                        op->value = predecode_read_compressed_u16(&pc);
+                        if (largeNotes) {
+                            op->arg = *pc++;
+                            op->arg2 = *pc++;
+                        }
+                        break;
+
+                    case 0x40: // layer_note1
+                        if (largeNotes) {
+                            op->value = predecode_read_compressed_u16(&pc);
+                            op->arg = *pc++;
+                        }
+                        break;
+
+                    case 0x80: // layer_note2
+                        if (largeNotes) {
+                            op->arg = *pc++;
+                            op->arg2 = *pc++;
+                        }
+                        break;
+                }
+                break;
+        }
+
+        // A command cut off by the end of the sequence read past it, so don't trust its arguments.
+        if ((u32) (pc - seqData) > state->seqLength) {
+            op->flags = ((op->flags & ~M64_OP_TARGET_OFFSET) | M64_OP_FALLBACK);
+            break;
+        }
+        offset = (pc - seqData);
+    }
+
+    run->end = op->offset;
+    if (!(op->flags & M64_OP_FALLBACK)) {
+        run->end = offset;
+    }
+    run->numOps = (state->numOps - run->firstOp);
+
+    return run->firstOp;
+}
+
+/**
+ * Get the op for the script starting at offset, decoding it and everything it jumps to or calls if it hasn't been yet.
+ */
+static s32 seq_predecode_layer(struct SeqPredecodeState *state, u8 *seqData, u16 offset, u8 largeNotes) {
+    s32 firstNewOp = state->numOps;
+    s32 index = find_decoded_op(state, offset, largeNotes);
+    s32 i;
+
+    if (index >= 0) {
+        return index;
+    }
+
+    index = decode_run(state, seqData, offset, largeNotes);
+
+    // Runs decoded here add more ops to resolve, so this keeps going until everything reachable is decoded.
+    for (i = firstNewOp; i < state->numOps; i++) {
+        struct M64LayerOp *op = &state->ops[i];
+
+        if (op->flags & M64_OP_TARGET_OFFSET) {
+            s32 target = find_decoded_op(state, op->value, largeNotes);
+
+            if (target < 0) {
+                target = decode_run(state, seqData, op->value, largeNotes);
+            }
+
+            op->flags &= ~M64_OP_TARGET_OFFSET;
+            if (target < 0) {
+                op->flags |= M64_OP_FALLBACK;
+            } else {
+                op->value = target;
+            }
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Called after a channel points a layer at a new script.
+ */
+void seq_predecode_layer_start(struct SequenceChannelLayer *layer) {
+    struct SequenceChannel *seqChannel = layer->seqChannel;
+    struct SequencePlayer *seqPlayer = seqChannel->seqPlayer;
+    struct SeqPredecodeState *state = get_predecode_state(seqPlayer);
+    s32 index;
+
+    layer->decodedOp = NULL;
+    if (state->disabled) {
+        return;
+    }
+
+    index = seq_predecode_layer(state, seqPlayer->seqData, (layer->scriptState.pc - seqPlayer->seqData), seqChannel->largeNotes);
+    if (index >= 0) {
+        layer->decodedOp = &state->ops[index];
+    }
+}
+
+/**
+ * Called when a channel writes to the sequence data. If the write lands in a decoded script, the ops no longer match
+ * the bytecode, so every layer of the player goes back to running from the bytecode until the next sequence is loaded.
+ */
+void seq_predecode_invalidate(struct SequencePlayer *seqPlayer, u16 offset) {
+    struct SeqPredecodeState *state = get_predecode_state(seqPlayer);
+    s32 i, j;
+
+    for (i = 0; i < state->numRuns; i++) {
+        if (offset >= state->runs[i].start && offset < state->runs[i].end) {
+            break;
+        }
+    }
+    if (i == state->numRuns) {
+        return;
+    }
+
+    state->disabled = TRUE;
+    for (i = 0; i < CHANNELS_MAX; i++) {
+        struct SequenceChannel *seqChannel = seqPlayer->channels[i];
+
+        if (!IS_SEQUENCE_CHANNEL_VALID(seqChannel)) {
+            continue;
+        }
+        for (j = 0; j < LAYERS_MAX; j++) {
+            struct SequenceChannelLayer *layer = seqChannel->layers[j];
+
+            if (layer != NULL && layer->decodedOp != NULL) {
+                layer->scriptState.pc = (seqPlayer->seqData + layer->decodedOp->offset);
+                layer->decodedOp = NULL;
+            }
+        }
+    }
+}
+
+/**
+ * The decoded version of the command loop in seq_channel_layer_process_script. Runs ops until the next layer_delay or
+ * note and reads their arguments the same way. Returns the semitone of a note (and its length in playPercentage),
+ * or one of PREDECODE_LAYER_DELAY, PREDECODE_LAYER_DISABLED or PREDECODE_LAYER_FALLBACK. After a fallback, the layer
+ * continues from scriptState.pc; the return addresses in scriptState.stack are always kept up to date for this.
+ */
+s32 seq_layer_process_decoded_ops(struct SequenceChannelLayer *layer, u16 *playPercentage) {
+    struct SequenceChannel *seqChannel = layer->seqChannel;
+    struct SequencePlayer *seqPlayer = seqChannel->seqPlayer;
+    struct M64ScriptState *state = &layer->scriptState;
+    struct M64LayerOp *ops = get_predecode_state(seqPlayer)->ops;
+    struct M64LayerOp *op = layer->decodedOp;
+    u16 sp3A = 0;
+    s32 vel = 0;
+    u8 semitone;
+
+    for (;;) {
+        if (op->flags & M64_OP_FALLBACK) {
+            goto fallback;
+        }
+        if (op->cmd <= 0xc0) {
+            break;
+        }
+
+        switch (op->cmd) {
+            case 0xff: // layer_end
+                if (state->depth == 0) {
+                    seq_channel_layer_disable(layer);
+                    layer->decodedOp = NULL;
+                    return PREDECODE_LAYER_DISABLED;
+                }
+                state->depth--;
+                op = layer->decodedStack[state->depth];
+                continue;
+
+            case 0xfc: // layer_call
+                state->stack[state->depth] = (seqPlayer->seqData + op[1].offset);
+                layer->decodedStack[state->depth] = &op[1];
+                state->depth++;
+                op = &ops[op->value];
+                continue;
+
+            case 0xf8: // layer_loop
+                state->remLoopIters[state->depth] = op->arg;
+                state->stack[state->depth] = (seqPlayer->seqData + op[1].offset);
+                layer->decodedStack[state->depth] = &op[1];
+                state->depth++;
+                break;
+
+            case 0xf7: // layer_loopend
+                if (--state->remLoopIters[state->depth - 1] != 0) {
+                    op = layer->decodedStack[state->depth - 1];
+                    continue;
+                }
+                state->depth--;
+                break;
+
+            case 0xfb: // layer_jump
+                op = &ops[op->value];
+                continue;
+
+            case 0xc1: // layer_setshortnotevelocity
+                layer->velocitySquare = (f32)(op->arg * op->arg);
+                break;
+
+            case 0xca: // layer_setpan
+                layer->pan = (f32) op->arg / 128.0f;
+                break;
+
+            case 0xc2: // layer_transpose
+                layer->transposition = op->arg;
+                break;
+
+            case 0xc9: // layer_setshortnoteduration
+                layer->noteDuration = op->arg;
+                break;
+
+            case 0xc4: // layer_somethingon
+            case 0xc5: // layer_somethingoff
+                layer->continuousNotes = (op->cmd == 0xc4);
+                seq_channel_layer_note_decay(layer);
+                break;
+
+            case 0xc3: // layer_setshortnotedefaultplaypercentage
+                layer->shortNoteDefaultPlayPercentage = op->value;
+                break;
+
+            case 0xc6: // layer_setinstr
+                if (op->arg < 127) {
+                    get_instrument(seqChannel, op->arg, &layer->instrument, &layer->adsr);
+                }
+                break;
+
+            case 0xc7: // layer_portamento
+                layer->portamento.mode = op->arg;
+                semitone = (op->arg2 + seqChannel->transposition + layer->transposition + seqPlayer->transposition);
+                if (semitone >= 0x80) {
+                    semitone = 0;
+                }
+                layer->portamentoTargetNote = semitone;
+                layer->portamentoTime = op->value;
+                break;
+
+            case 0xc8: // layer_disableportamento
+                layer->portamento.mode = 0;
+                break;
+
+            default:
+                switch (op->cmd & 0xf0) {
+                    case 0xd0: // layer_setshortnotevelocityfromtable
+                        sp3A = seqPlayer->shortNoteVelocityTable[op->cmd & 0xf];
+                        layer->velocitySquare = (f32)(sp3A * sp3A);
+                        break;
+                    case 0xe0: // layer_setshortnotedurationfromtable
+                        layer->noteDuration = seqPlayer->shortNoteDurationTable[op->cmd & 0xf];
+                        break;
+                }
+                break;
+        }
+        op++;
+    }
+
+    if (op->cmd == 0xc0) { // layer_delay
+        layer->delay = op->value;
+        layer->stopSomething = TRUE;
+        layer->decodedOp = &op[1];
+        return PREDECODE_LAYER_DELAY;
+    }
+
+    // The channel switched note lengths since this was decoded.
+    if (!(op->flags & M64_OP_LARGE_NOTES) != !seqChannel->largeNotes) {
+        goto fallback;
+    }
+
+    layer->stopSomething = FALSE;
+    if (seqChannel->largeNotes == TRUE) {
+        switch (op->cmd & 0xc0) {
+            case 0x00: // layer_note0 (play percentage, velocity, duration)
+                sp3A = op->value;
+                vel = op->arg;
+                layer->noteDuration = op->arg2;
+                layer->playPercentage = sp3A;
+                break;
+
+            case 0x40: // layer_note1 (play percentage, velocity)
+                sp3A = op->value;
+                vel = op->arg;
+                layer->noteDuration = 0;
+                layer->playPercentage = sp3A;
+                break;
+
+            case 0x80: // layer_note2 (velocity, duration; uses last play percentage)
+                sp3A = layer->playPercentage;
+                vel = op->arg;
+                layer->noteDuration = op->arg2;
+                break;
+        }
+        layer->velocitySquare = vel * vel;
+    } else {
+        switch (op->cmd & 0xc0) {
+            case 0x00: // play note, type 0 (play percentage)
+                sp3A = op->value;
+                layer->playPercentage = sp3A;
+                break;
+
+            case 0x40: // play note, type 1 (uses default play percentage)
+                sp3A = layer->shortNoteDefaultPlayPercentage;
+                break;
+
+            case 0x80: // play note, type 2 (uses last play percentage)
+                sp3A = layer->playPercentage;
+                break;
+        }
+    }
+
+    layer->decodedOp = &op[1];
+    *playPercentage = sp3A;
+    return (op->cmd - (op->cmd & 0xc0));
+
+fallback:
+    state->pc = (seqPlayer->seqData + op->offset);
+    layer->decodedOp = NULL;
+    return PREDECODE_LAYER_FALLBACK;
+}
+
+#endif // PREDECODE_SEQUENCES
@@ -0,0 +1,30 @@
+#ifndef AUDIO_SEQ_PREDECODE_H
+#define AUDIO_SEQ_PREDECODE_H
+
+#include <PR/ultratypes.h>
+
+#include "internal.h"
+
+enum M64LayerOpFlags {
+    M64_OP_LARGE_NOTES   = (1 << 0), // decoded for a channel with largeNotes set, which changes the length of notes
+    M64_OP_FALLBACK      = (1 << 1), // not decoded; the script continues from the bytecode at offset
+    M64_OP_TARGET_OFFSET = (1 << 2), // only while decoding: value is still the offset the jump or call goes to
+};
+
+// What seq_layer_process_decoded_ops stopped on, when it isn't a note.
+#define PREDECODE_LAYER_DELAY    -1
+#define PREDECODE_LAYER_DISABLED -2
+#define PREDECODE_LAYER_FALLBACK -3
+
+#ifdef PREDECODE_SEQUENCES
+void seq_predecode_reset(u32 player, u32 seqId);
+void seq_predecode_layer_start(struct SequenceChannelLayer *layer);
+void seq_predecode_invalidate(struct SequencePlayer *seqPlayer, u16 offset);
+s32 seq_layer_process_decoded_ops(struct SequenceChannelLayer *layer, u16 *playPercentage);
+#else
+#define seq_predecode_reset(player, seqId)
+#define seq_predecode_layer_start(layer)
+#define seq_predecode_invalidate(seqPlayer, offset)
+#endif
+
+#endif // AUDIO_SEQ_PREDECODE_H
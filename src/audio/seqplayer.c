@@ -6,6 +6,7 @@
 #include "heap.h"
 #include "load.h"
 #include "seqplayer.h"
+#include "seq_predecode.h"
 #include "game/debug.h"
 #include "game/main.h"
 
@@ -123,6 +124,9 @@ s32 seq_channel_set_layer(struct SequenceChannel *seqChannel, s32 layerIndex) {
 #endif
     layer->portamento.mode = 0;
     layer->scriptState.depth = 0;
+#ifdef PREDECODE_SEQUENCES
+    layer->decodedOp = NULL;
+#endif
     layer->status = SOUND_LOAD_STATUS_NOT_LOADED;
     layer->noteDuration = 0x80;
 #if defined(VERSION_EU) || defined(VERSION_SH)
@@ -1819,6 +1823,7 @@ void sequence_channel_process_script(struct SequenceChannel *seqChannel) {
                             sp5A = m64_read_s16(state);
                             seqData = seqPlayer->seqData + sp5A;
                             *seqData = (u8)value + cmd;
+                            seq_predecode_invalidate(seqPlayer, sp5A);
                         }
                         break;
 
@@ -2116,6 +2121,7 @@ void sequence_channel_process_script(struct SequenceChannel *seqChannel) {
                         sp5A = m64_read_s16(state);
                         if (seq_channel_set_layer(seqChannel, loBits) == 0) {
                             seqChannel->layers[loBits]->scriptState.pc = seqPlayer->seqData + sp5A;
+                            seq_predecode_layer_start(seqChannel->layers[loBits]);
                         }
                         break;
 
@@ -2130,6 +2136,7 @@ void sequence_channel_process_script(struct SequenceChannel *seqChannel) {
                             seqData = (*seqChannel->dynTable)[(u8) value];
                             sp5A = ((seqData[0] << 8) + seqData[1]);
                             seqChannel->layers[loBits]->scriptState.pc = seqPlayer->seqData + sp5A;
+                            seq_predecode_layer_start(seqChannel->layers[loBits]);
                         }
                         break;
 
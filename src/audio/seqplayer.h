@@ -23,6 +23,8 @@ void sequence_player_disable(struct SequencePlayer* seqPlayer);
 void audio_list_push_back(struct AudioListItem *list, struct AudioListItem *item);
 void *audio_list_pop_back(struct AudioListItem *list);
 void process_sequences(s32 iterationsRemaining);
+u32 get_instrument(struct SequenceChannel *seqChannel, u8 instId, struct Instrument **instOut,
+                   struct AdsrSettings *adsr);
 void init_sequence_player(u32 player);
 void init_sequence_players(void);
 
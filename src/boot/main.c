@@ -112,6 +112,11 @@ void alloc_pool(void) {
     void *start = (void *) SEG_POOL_START;
     void *end = (void *) (SEG_POOL_START + POOL_SIZE);
 
+#ifdef SEGMENT_CACHE
+    // Reserve the top of RAM for the segment cache.
+    segment_cache_init((u8 *) end - SEGMENT_CACHE_SIZE, end);
+    end = (u8 *) end - SEGMENT_CACHE_SIZE;
+#endif
     main_pool_init(start, end);
     gEffectsMemoryPool = mem_pool_init(EFFECTS_MEMORY_POOL, MEMORY_POOL_LEFT);
 }
@@ -1,10 +1,12 @@
 #include <PR/ultratypes.h>
+#include <string.h>
 
 #include "sm64.h"
 
 #include "buffers/buffers.h"
 #include "dma_async.h"
 #include "slidec.h"
+#include "tlsf.h"
 #include "game/debug.h"
 #include "game/game_init.h"
 #include "game/main.h"
@@ -39,15 +41,12 @@ struct MainPoolBlock {
     struct MainPoolBlock *next;
 };
 
-struct MemoryBlock {
-    struct MemoryBlock *next;
-    u32 size;
+struct MemoryPool {
+    struct TlsfPool tlsf;
 };
 
-struct MemoryPool {
-    u32 totalSpace;
-    struct MemoryBlock *firstBlock;
-    struct MemoryBlock freeList;
+struct SlabBlock {
+    struct SlabBlock *next;
 };
 
 extern uintptr_t sSegmentTable[32];
@@ -66,6 +65,8 @@ struct MemoryPool *gEffectsMemoryPool;
 
 
 uintptr_t sSegmentTable[32];
+// ROM address each segment was loaded from, or 0 if it wasn't loaded from ROM.
+static uintptr_t sSegmentROMTable[32];
 u32 sPoolFreeSpace;
 u8 *sPoolStart;
 u8 *sPoolEnd;
@@ -75,11 +76,42 @@ struct MainPoolBlock *sPoolListHeadR;
 
 static struct MainPoolState *gMainPoolState = NULL;
 
+#ifdef STREAM_LEVEL_SEGMENTS
+struct StreamedSegment {
+    s32 segment;
+    u8 *srcStart;
+    u8 *srcEnd;
+    u8 *compressed;
+    void *dest;
+};
+
+// Streamed segments in the order they were queued. They're decompressed newest first,
+// since freeing a block from the right side of the main pool also frees everything newer.
+static struct StreamedSegment sStreamedSegments[STREAM_MAX_SEGMENTS];
+static s32 sNumStreamedSegments = 0;
+// Bitmask of segments that are queued but not decompressed yet.
+u32 gStreamedSegmentsPending = 0;
+// The right side list head from before the first queued segment's compressed data was allocated.
+static struct MainPoolBlock *sStreamPoolBaseR = NULL;
+
+static s32 stream_segments_survive_pop(struct MainPoolBlock *listHeadL);
+static void stream_segments_reserve_compressed(void);
+#endif
+
 uintptr_t set_segment_base_addr(s32 segment, void *addr) {
     sSegmentTable[segment] = ((uintptr_t) addr & 0x1FFFFFFF);
+    sSegmentROMTable[segment] = 0;
     return sSegmentTable[segment];
 }
 
+/**
+ * Returns the ROM address the segment's data was loaded from, or 0 if the segment
+ * was set directly instead of being loaded with load_segment(_decompress).
+ */
+uintptr_t get_segment_rom_addr(s32 segment) {
+    return sSegmentROMTable[segment];
+}
+
 UNUSED void *get_segment_base_addr(s32 segment) {
     return (void *) (sSegmentTable[segment] | 0x80000000);
 }
@@ -89,6 +121,11 @@ void *segmented_to_virtual(const void *addr) {
     size_t segment = ((uintptr_t) addr >> 24);
     size_t offset  = ((uintptr_t) addr & 0x00FFFFFF);
 
+#ifdef STREAM_LEVEL_SEGMENTS
+    if (gStreamedSegmentsPending != 0) {
+        stream_require_segment(segment);
+    }
+#endif
     return (void *) ((sSegmentTable[segment] + offset) | 0x80000000);
 }
 
@@ -235,6 +272,15 @@ u32 main_pool_push_state(void) {
     struct MainPoolBlock *lhead = sPoolListHeadL;
     struct MainPoolBlock *rhead = sPoolListHeadR;
 
+#ifdef STREAM_LEVEL_SEGMENTS
+    // Record the pool as if streamed segments had already been decompressed, so popping
+    // this state later doesn't bring back compressed data that has been freed since.
+    if (sNumStreamedSegments > 0) {
+        freeSpace += ((uintptr_t) sStreamPoolBaseR - (uintptr_t) rhead);
+        rhead = sStreamPoolBaseR;
+    }
+#endif
+
     gMainPoolState = main_pool_alloc(sizeof(*gMainPoolState), MEMORY_POOL_LEFT);
     gMainPoolState->freeSpace = freeSpace;
     gMainPoolState->listHeadL = lhead;
@@ -248,10 +294,20 @@ u32 main_pool_push_state(void) {
  * amount of free space left in the pool.
  */
 u32 main_pool_pop_state(void) {
+#ifdef STREAM_LEVEL_SEGMENTS
+    // Popping back past the buffers streamed segments decompress into, like CLEAR_LEVEL and EXIT do,
+    // means they have to be finished now. Any other pop, like the one in load_area, keeps them queued.
+    if (!stream_segments_survive_pop(gMainPoolState->listHeadL)) {
+        stream_segments_finish_all();
+    }
+#endif
     sPoolFreeSpace = gMainPoolState->freeSpace;
     sPoolListHeadL = gMainPoolState->listHeadL;
     sPoolListHeadR = gMainPoolState->listHeadR;
     gMainPoolState = gMainPoolState->prev;
+#ifdef STREAM_LEVEL_SEGMENTS
+    stream_segments_reserve_compressed();
+#endif
     return sPoolFreeSpace;
 }
 
@@ -341,6 +397,9 @@ void *load_segment(s32 segment, u8 *srcStart, u8 *srcEnd, u32 side, u8 *bssStart
             set_segment_base_addr(segment, addr);
         }
     }
+    if (addr != NULL) {
+        sSegmentROMTable[segment] = (uintptr_t) srcStart;
+    }
 #ifdef PUPPYPRINT_DEBUG
     u32 ppSize = ALIGN16(srcEnd - srcStart) + 16;
     set_segment_memory_printout(segment, ppSize);
@@ -357,6 +416,10 @@ void *load_segment(s32 segment, u8 *srcStart, u8 *srcEnd, u32 side, u8 *bssStart
 void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd) {
     void *dest = NULL;
     u32 srcSize = ALIGN16(srcEnd - srcStart);
+#ifdef STREAM_LEVEL_SEGMENTS
+    // Streamed segments keep their compressed data on the right side of the pool.
+    stream_segments_finish_all();
+#endif
     u32 destSize = ALIGN16((u8 *) sPoolListHeadR - destAddr);
 
     if (srcSize <= destSize) {
@@ -372,70 +435,239 @@ void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd) {
     return dest;
 }
 
+#ifdef SEGMENT_CACHE
+struct SegmentCacheEntry {
+    /*0x00*/ u8 *romStart; // NULL if the entry is free.
+    /*0x04*/ u8 *romEnd;
+    /*0x08*/ u8 *addr;
+    /*0x0C*/ u32 size;
+    /*0x10*/ u32 lastUsed;
+}; /*0x14*/
+
+static struct SegmentCacheEntry sSegmentCache[SEGMENT_CACHE_ENTRIES];
+static u8 *sSegmentCacheStart;
+static u8 *sSegmentCacheEnd;
+static u32 sSegmentCacheTime = 0;
+
+/**
+ * Set up the segment cache in the given block of memory, which must not be part of the main pool.
+ */
+void segment_cache_init(void *start, void *end) {
+    sSegmentCacheStart = (u8 *) ALIGN16((uintptr_t) start);
+    sSegmentCacheEnd = (u8 *) end;
+    bzero(sSegmentCache, sizeof(sSegmentCache));
+}
+
+static struct SegmentCacheEntry *segment_cache_find(u8 *srcStart, u8 *srcEnd) {
+    for (s32 i = 0; i < SEGMENT_CACHE_ENTRIES; i++) {
+        if (sSegmentCache[i].romStart == srcStart && sSegmentCache[i].romEnd == srcEnd) {
+            return &sSegmentCache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * An entry can't be evicted while a segment other than the one being loaded still points to it.
+ * Segments aren't cleared when their level is unloaded, so this errs on the side of keeping entries.
+ */
+static s32 segment_cache_entry_in_use(struct SegmentCacheEntry *entry, s32 loadingSegment) {
+    uintptr_t physAddr = ((uintptr_t) entry->addr & 0x1FFFFFFF);
+
+    for (s32 segment = 0; segment < ARRAY_COUNT(sSegmentTable); segment++) {
+        if (segment != loadingSegment && sSegmentTable[segment] == physAddr) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * Evict the least recently used entry that isn't in use. Returns FALSE if there wasn't one.
+ */
+static s32 segment_cache_evict(s32 loadingSegment) {
+    struct SegmentCacheEntry *lru = NULL;
+
+    for (s32 i = 0; i < SEGMENT_CACHE_ENTRIES; i++) {
+        struct SegmentCacheEntry *entry = &sSegmentCache[i];
+
+        if (entry->romStart != NULL && (lru == NULL || entry->lastUsed < lru->lastUsed)
+            && !segment_cache_entry_in_use(entry, loadingSegment)) {
+            lru = entry;
+        }
+    }
+
+    if (lru == NULL) {
+        return FALSE;
+    }
+
+    lru->romStart = NULL;
+    lru->romEnd   = NULL;
+    return TRUE;
+}
+
+/**
+ * Find a gap of at least size bytes between the entries, trying the start of the cache and the end of every entry.
+ */
+static u8 *segment_cache_find_space(u32 size) {
+    u8 *start = sSegmentCacheStart;
+
+    for (s32 i = -1; i < SEGMENT_CACHE_ENTRIES; i++) {
+        if (i >= 0) {
+            if (sSegmentCache[i].romStart == NULL) {
+                continue;
+            }
+            start = (sSegmentCache[i].addr + sSegmentCache[i].size);
+        }
+
+        if ((start + size) > sSegmentCacheEnd) {
+            continue;
+        }
+
+        s32 j;
+        for (j = 0; j < SEGMENT_CACHE_ENTRIES; j++) {
+            struct SegmentCacheEntry *entry = &sSegmentCache[j];
+
+            if (entry->romStart != NULL && start < (entry->addr + entry->size) && entry->addr < (start + size)) {
+                break;
+            }
+        }
+        if (j == SEGMENT_CACHE_ENTRIES) {
+            return start;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Allocate a cache entry for the segment at srcStart, evicting older entries until it fits.
+ * Returns NULL if it doesn't fit, in which case the segment should be loaded into the main pool instead.
+ */
+static void *segment_cache_alloc(s32 segment, u8 *srcStart, u8 *srcEnd, u32 size) {
+    struct SegmentCacheEntry *entry = segment_cache_find(NULL, NULL);
+    u8 *addr;
+
+    size = ALIGN16(size);
+    if (size > (u32)(sSegmentCacheEnd - sSegmentCacheStart)) {
+        return NULL;
+    }
+
+    while (entry == NULL) {
+        if (!segment_cache_evict(segment)) {
+            return NULL;
+        }
+        entry = segment_cache_find(NULL, NULL);
+    }
+
+    while ((addr = segment_cache_find_space(size)) == NULL) {
+        if (!segment_cache_evict(segment)) {
+            return NULL;
+        }
+    }
+
+    entry->romStart = srcStart;
+    entry->romEnd   = srcEnd;
+    entry->addr     = addr;
+    entry->size     = size;
+    entry->lastUsed = ++sSegmentCacheTime;
+    return addr;
+}
+#endif
+
+/**
+ * Allocate the buffer a segment is decompressed into, from the segment cache if it's cacheable and fits.
+ */
+static void *alloc_decompressed_segment(UNUSED s32 segment, UNUSED u8 *srcStart, UNUSED u8 *srcEnd, u32 size,
+                                        UNUSED s32 cacheable) {
+#ifdef SEGMENT_CACHE
+    if (cacheable) {
+        void *dest = segment_cache_alloc(segment, srcStart, srcEnd, size);
+        if (dest != NULL) {
+            return dest;
+        }
+    }
+#endif
+    return main_pool_alloc(size, MEMORY_POOL_LEFT);
+}
+
 #if defined(LZ4T) || defined(GZIP)
 #define DMA_ASYNC_HEADER_SIZE 16
 #else
 #define DMA_ASYNC_HEADER_SIZE 0
 #endif
 
+#ifndef UNCOMPRESSED
 /**
- * Decompress the block of ROM data from srcStart to srcEnd and return a
- * pointer to an allocated buffer holding the decompressed data. Set the
- * base address of segment to this address.
+ * Read a compressed segment into compressed and decompress it into dest.
+ * The first 16 bytes (the header) must already have been read into compressed.
  */
-void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
-    void *dest = NULL;
-
-    u32 compSize = ALIGN16(srcEnd - srcStart);
-
+static void decompress_segment_data(u8 *compressed, void *dest, u8 *srcStart, u8 *srcEnd) {
 #ifdef GZIP
     struct libdeflate_decompressor *dec = libdeflate_alloc_decompressor();
     aggress(dec != NULL, "Failed to allocate GZIP decompressor!");
 #endif
 
-    u8 *compressed = main_pool_alloc(compSize, MEMORY_POOL_RIGHT);
-    // Decompressed size from header (This works for non-mio0 because they also have the size in same place)
-    u32 *size = (u32 *) (compressed + 4);
-    if (compressed != NULL) {
-#ifdef UNCOMPRESSED
-        dest = main_pool_alloc(compSize, MEMORY_POOL_LEFT);
-        dma_read(dest, srcStart, srcEnd);
+#if DMA_ASYNC_HEADER_SIZE
+    struct DMAAsyncCtx asyncCtx;
+    dma_async_ctx_init(&asyncCtx, compressed + DMA_ASYNC_HEADER_SIZE, srcStart + DMA_ASYNC_HEADER_SIZE, srcEnd);
 #else
-# if DMA_ASYNC_HEADER_SIZE
-        dma_read(compressed, srcStart, srcStart + DMA_ASYNC_HEADER_SIZE);
-        struct DMAAsyncCtx asyncCtx;
-        dma_async_ctx_init(&asyncCtx, compressed + DMA_ASYNC_HEADER_SIZE, srcStart + DMA_ASYNC_HEADER_SIZE, srcEnd);
-# else
-        dma_read(compressed, srcStart, srcEnd);
-# endif
-        dest = main_pool_alloc(*size, MEMORY_POOL_LEFT);
+    dma_read(compressed, srcStart, srcEnd);
 #endif
-        if (dest != NULL) {
-            osSyncPrintf("start decompress\n");
+
+    osSyncPrintf("start decompress\n");
 #ifdef GZIP
-            libdeflate_deflate_decompress(dec, compressed + 16, *(u32*) (compressed + 8), dest, &asyncCtx);
+    libdeflate_deflate_decompress(dec, compressed + 16, *(u32*) (compressed + 8), dest, &asyncCtx);
 #elif RNC1
-            Propack_UnpackM1(compressed, dest);
+    Propack_UnpackM1(compressed, dest);
 #elif RNC2
-            Propack_UnpackM2(compressed, dest);
+    Propack_UnpackM2(compressed, dest);
 #elif YAY0
-            slidstart(compressed, dest);
+    slidstart(compressed, dest);
 #elif MIO0
-            decompress(compressed, dest);
+    decompress(compressed, dest);
 #elif LZ4T
-            lz4t_unpack(compressed, dest, &asyncCtx);
+    lz4t_unpack(compressed, dest, &asyncCtx);
 #endif
-            osSyncPrintf("end decompress\n");
-            set_segment_base_addr(segment, dest);
-            main_pool_free(compressed);
-        }
-    }
+    osSyncPrintf("end decompress\n");
 
 #ifdef GZIP
     if (dec) {
         libdeflate_free_decompressor(dec);
     }
 #endif
+}
+#endif
+
+/**
+ * Decompress a segment into a newly allocated buffer, which is in the segment cache if cacheable is set and it fits.
+ */
+static void *decompress_segment(s32 segment, u8 *srcStart, u8 *srcEnd, s32 cacheable) {
+    void *dest = NULL;
+    u32 compSize = ALIGN16(srcEnd - srcStart);
+
+    u8 *compressed = main_pool_alloc(compSize, MEMORY_POOL_RIGHT);
+    // Decompressed size from header (This works for non-mio0 because they also have the size in same place)
+    u32 *size = (u32 *) (compressed + 4);
+    if (compressed != NULL) {
+#ifdef UNCOMPRESSED
+        dest = alloc_decompressed_segment(segment, srcStart, srcEnd, compSize, cacheable);
+        dma_read(dest, srcStart, srcEnd);
+#else
+        dma_read(compressed, srcStart, srcStart + 16);
+        dest = alloc_decompressed_segment(segment, srcStart, srcEnd, *size, cacheable);
+#endif
+        if (dest != NULL) {
+#ifndef UNCOMPRESSED
+            decompress_segment_data(compressed, dest, srcStart, srcEnd);
+#endif
+            set_segment_base_addr(segment, dest);
+            sSegmentROMTable[segment] = (uintptr_t) srcStart;
+            main_pool_free(compressed);
+        }
+    }
 
 #ifdef PUPPYPRINT_DEBUG
     u32 ppSize = ALIGN16((u32)*size) + 16;
@@ -444,6 +676,164 @@ void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
     return dest;
 }
 
+/**
+ * Decompress the block of ROM data from srcStart to srcEnd and return a
+ * pointer to an allocated buffer holding the decompressed data. Set the
+ * base address of segment to this address.
+ */
+void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
+    return decompress_segment(segment, srcStart, srcEnd, FALSE);
+}
+
+#ifdef SEGMENT_CACHE
+/**
+ * Like load_segment_decompress, but reuses a copy kept in the segment cache if there is one, and keeps
+ * the segment there for next time otherwise. Only for segments that are never written to at runtime,
+ * since the next load gets the cached data as it was left.
+ */
+void *load_segment_decompress_cached(s32 segment, u8 *srcStart, u8 *srcEnd) {
+    struct SegmentCacheEntry *cached = segment_cache_find(srcStart, srcEnd);
+
+    if (cached != NULL) {
+        cached->lastUsed = ++sSegmentCacheTime;
+        set_segment_base_addr(segment, cached->addr);
+        sSegmentROMTable[segment] = (uintptr_t) srcStart;
+#ifdef PUPPYPRINT_DEBUG
+        set_segment_memory_printout(segment, (cached->size + 16));
+#endif
+        return cached->addr;
+    }
+
+    return decompress_segment(segment, srcStart, srcEnd, TRUE);
+}
+#endif
+
+#ifdef STREAM_LEVEL_SEGMENTS
+
+/**
+ * Like load_segment_decompress, but only allocates the segment and reads its header. The data is decompressed
+ * later by stream_segments_update, or as soon as the segment is accessed through stream_require_segment.
+ * Falls back to loading the segment right away if it can't be queued.
+ */
+void *load_segment_decompress_streamed(s32 segment, u8 *srcStart, u8 *srcEnd) {
+    struct StreamedSegment *stream;
+    u8 *compressed;
+    void *dest;
+
+    // Streamed segments are actor groups, which are never written to, so they can always go in the segment cache.
+#ifdef SEGMENT_CACHE
+    if (segment_cache_find(srcStart, srcEnd) != NULL) {
+        return load_segment_decompress_cached(segment, srcStart, srcEnd);
+    }
+#endif
+    if (sNumStreamedSegments >= STREAM_MAX_SEGMENTS || (gStreamedSegmentsPending & (1 << segment))) {
+        return load_segment_decompress_cached(segment, srcStart, srcEnd);
+    }
+
+    if (sNumStreamedSegments == 0) {
+        sStreamPoolBaseR = sPoolListHeadR;
+    }
+    compressed = main_pool_alloc(ALIGN16(srcEnd - srcStart), MEMORY_POOL_RIGHT);
+    if (compressed == NULL) {
+        return NULL;
+    }
+    dma_read(compressed, srcStart, srcStart + 16);
+    dest = alloc_decompressed_segment(segment, srcStart, srcEnd, *(u32 *) (compressed + 4), TRUE);
+    if (dest == NULL) {
+        main_pool_free(compressed);
+        return NULL;
+    }
+
+    set_segment_base_addr(segment, dest);
+    sSegmentROMTable[segment] = (uintptr_t) srcStart;
+#ifdef PUPPYPRINT_DEBUG
+    set_segment_memory_printout(segment, (ALIGN16(*(u32 *) (compressed + 4)) + 16));
+#endif
+
+    stream = &sStreamedSegments[sNumStreamedSegments++];
+    stream->segment = segment;
+    stream->srcStart = srcStart;
+    stream->srcEnd = srcEnd;
+    stream->compressed = compressed;
+    stream->dest = dest;
+    gStreamedSegmentsPending |= (1 << segment);
+    return dest;
+}
+
+/**
+ * Decompress the most recently queued streamed segment.
+ */
+static void stream_finish_newest(void) {
+    struct StreamedSegment *stream = &sStreamedSegments[--sNumStreamedSegments];
+
+    decompress_segment_data(stream->compressed, stream->dest, stream->srcStart, stream->srcEnd);
+    main_pool_free(stream->compressed);
+    gStreamedSegmentsPending &= ~(1 << stream->segment);
+    append_puppyprint_log("Streamed segment %02X in on frame %d.", stream->segment, gGlobalTimer);
+}
+
+/**
+ * Make sure a streamed segment has been decompressed before it's used.
+ * Segments queued after it are decompressed first, so their compressed data can be freed in order.
+ */
+void stream_require_segment(u32 segment) {
+    if (segment < NUM_TLB_SEGMENTS && (gStreamedSegmentsPending & (1 << segment))) {
+        while (gStreamedSegmentsPending & (1 << segment)) {
+            stream_finish_newest();
+        }
+    }
+}
+
+/**
+ * Decompress one queued segment. Called once per frame.
+ */
+void stream_segments_update(void) {
+    if (sNumStreamedSegments > 0) {
+        stream_finish_newest();
+    }
+}
+
+/**
+ * Decompress everything that's still queued, before the memory it was queued into goes away.
+ */
+void stream_segments_finish_all(void) {
+    while (sNumStreamedSegments > 0) {
+        stream_finish_newest();
+    }
+}
+
+/**
+ * Whether restoring a pool state with this left list head keeps every queued segment's decompression buffer.
+ * Buffers in the segment cache are outside the main pool, so they always survive.
+ */
+static s32 stream_segments_survive_pop(struct MainPoolBlock *listHeadL) {
+    for (s32 i = 0; i < sNumStreamedSegments; i++) {
+        u8 *dest = sStreamedSegments[i].dest;
+
+        if (dest >= sPoolStart && dest < sPoolEnd && dest >= (u8 *) listHeadL) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Pool states are pushed without the compressed data of queued segments (see main_pool_push_state),
+ * so after one is popped, allocate that data on the right side again. It hasn't moved.
+ */
+static void stream_segments_reserve_compressed(void) {
+    if (sNumStreamedSegments > 0) {
+        assert(sPoolListHeadR == sStreamPoolBaseR, "Popped a pool state from before the streamed segments!");
+        struct MainPoolBlock *newest = (struct MainPoolBlock *)
+            (sStreamedSegments[sNumStreamedSegments - 1].compressed - 16);
+
+        sPoolFreeSpace -= ((uintptr_t) sPoolListHeadR - (uintptr_t) newest);
+        sPoolListHeadR = newest;
+        sPoolListHeadR->prev = NULL;
+    }
+}
+#endif
+
 void load_engine_code_segment(void) {
     void *startAddr = (void *) _engineSegmentStart;
     u32 totalSize = _engineSegmentEnd - _engineSegmentStart;
@@ -513,29 +903,21 @@ struct AllocOnlyPool *alloc_only_pool_resize(struct AllocOnlyPool *pool, u32 siz
 
 /**
  * Allocate a memory pool from the main pool. This pool supports arbitrary
- * order for allocation/freeing.
+ * order for allocation/freeing, in constant time (see tlsf.c).
  * Return NULL if there is not enough space in the main pool.
  */
 struct MemoryPool *mem_pool_init(u32 size, u32 side) {
-    void *addr;
-    struct MemoryBlock *block;
-    struct MemoryPool *pool = NULL;
+    struct MemoryPool *pool;
 
-    size = ALIGN4(size);
-    addr = main_pool_alloc(size + sizeof(struct MemoryPool), side);
-    if (addr != NULL) {
-        pool = (struct MemoryPool *) addr;
-
-        pool->totalSpace = size;
-        pool->firstBlock = (struct MemoryBlock *) ((u8 *) addr + sizeof(struct MemoryPool));
-        pool->freeList.next = (struct MemoryBlock *) ((u8 *) addr + sizeof(struct MemoryPool));
-
-        block = pool->firstBlock;
-        block->next = NULL;
-        block->size = pool->totalSpace;
+    // Leave room for the header that marks the end of the pool.
+    size = ALIGN16(size) + 16;
+    aggress(size < TLSF_MAX_POOL_SIZE, "Memory pool is too large!");
+    pool = main_pool_alloc(size + sizeof(struct MemoryPool), side);
+    if (pool != NULL) {
+        tlsf_init(&pool->tlsf, (u8 *) pool + sizeof(struct MemoryPool), size);
     }
 #ifdef PUPPYPRINT_DEBUG
-    gPoolMem += ALIGN16(size) + 16;
+    gPoolMem += ALIGN16(size + sizeof(struct MemoryPool)) + 16;
 #endif
     return pool;
 }
@@ -544,69 +926,86 @@ struct MemoryPool *mem_pool_init(u32 size, u32 side) {
  * Allocate from a memory pool. Return NULL if there is not enough space.
  */
 void *mem_pool_alloc(struct MemoryPool *pool, u32 size) {
-    struct MemoryBlock *freeBlock = &pool->freeList;
-    void *addr = NULL;
-
-    size = ALIGN4(size) + sizeof(struct MemoryBlock);
-    while (freeBlock->next != NULL) {
-        if (freeBlock->next->size >= size) {
-            addr = (u8 *) freeBlock->next + sizeof(struct MemoryBlock);
-            if (freeBlock->next->size - size <= sizeof(struct MemoryBlock)) {
-                freeBlock->next = freeBlock->next->next;
-            } else {
-                struct MemoryBlock *newBlock = (struct MemoryBlock *) ((u8 *) freeBlock->next + size);
-                newBlock->size = freeBlock->next->size - size;
-                newBlock->next = freeBlock->next->next;
-                freeBlock->next->size = size;
-                freeBlock->next = newBlock;
-            }
-            break;
-        }
-        freeBlock = freeBlock->next;
-    }
-    return addr;
+    return tlsf_alloc(&pool->tlsf, size);
 }
 
 /**
  * Free a block that was allocated using mem_pool_alloc.
  */
 void mem_pool_free(struct MemoryPool *pool, void *addr) {
-    struct MemoryBlock *block = (struct MemoryBlock *) ((u8 *) addr - sizeof(struct MemoryBlock));
-    struct MemoryBlock *freeList = pool->freeList.next;
+    tlsf_free(&pool->tlsf, addr);
+}
 
-    if (pool->freeList.next == NULL) {
-        pool->freeList.next = block;
-        block->next = NULL;
-    } else {
-        if (block < pool->freeList.next) {
-            if ((u8 *) pool->freeList.next == (u8 *) block + block->size) {
-                block->size += freeList->size;
-                block->next = freeList->next;
-                pool->freeList.next = block;
-            } else {
-                block->next = pool->freeList.next;
-                pool->freeList.next = block;
-            }
-        } else {
-            while (freeList->next != NULL) {
-                if (freeList < block && block < freeList->next) {
-                    break;
-                }
-                freeList = freeList->next;
-            }
-            if ((u8 *) freeList + freeList->size == (u8 *) block) {
-                freeList->size += block->size;
-                block = freeList;
-            } else {
-                block->next = freeList->next;
-                freeList->next = block;
-            }
-            if (block->next != NULL && (u8 *) block->next == (u8 *) block + block->size) {
-                block->size = block->size + block->next->size;
-                block->next = block->next->next;
-            }
+/**
+ * Get the usage, high water mark and largest free block of a memory pool.
+ */
+void mem_pool_get_stats(struct MemoryPool *pool, struct TlsfStats *stats) {
+    tlsf_get_stats(&pool->tlsf, stats);
+}
+
+/**
+ * Allocate a slab pool of numBlocks blocks of blockSize bytes each from the main pool.
+ * Every block is the same size, so allocating and freeing just pop and push the
+ * free list, and the pool can never fragment.
+ * Return NULL if there is not enough space in the main pool.
+ */
+struct SlabPool *slab_pool_init(u32 blockSize, u32 numBlocks, u32 side) {
+    struct SlabPool *pool;
+    struct SlabBlock *block;
+    u32 i;
+
+    if (blockSize < sizeof(struct SlabBlock)) {
+        blockSize = sizeof(struct SlabBlock);
+    }
+    blockSize = ALIGN8(blockSize);
+    pool = main_pool_alloc(ALIGN8(sizeof(struct SlabPool)) + (blockSize * numBlocks), side);
+    if (pool != NULL) {
+        pool->blockSize = blockSize;
+        pool->numBlocks = numBlocks;
+        pool->numUsed = 0;
+        pool->highWater = 0;
+        pool->start = (u8 *) pool + ALIGN8(sizeof(struct SlabPool));
+        pool->freeList = NULL;
+        // Build the free list backwards, so blocks are handed out in address order.
+        for (i = numBlocks; i > 0; i--) {
+            block = (struct SlabBlock *) (pool->start + ((i - 1) * blockSize));
+            block->next = pool->freeList;
+            pool->freeList = block;
+        }
+#ifdef PUPPYPRINT_DEBUG
+        gPoolMem += ALIGN16(ALIGN8(sizeof(struct SlabPool)) + (blockSize * numBlocks)) + 16;
+#endif
+    }
+    return pool;
+}
+
+/**
+ * Allocate a block from a slab pool. Return NULL if every block is in use.
+ */
+void *slab_pool_alloc(struct SlabPool *pool) {
+    struct SlabBlock *block = pool->freeList;
+
+    if (block != NULL) {
+        pool->freeList = block->next;
+        pool->numUsed++;
+        if (pool->numUsed > pool->highWater) {
+            pool->highWater = pool->numUsed;
         }
     }
+    return block;
+}
+
+/**
+ * Free a block that was allocated using slab_pool_alloc.
+ */
+void slab_pool_free(struct SlabPool *pool, void *addr) {
+    struct SlabBlock *block = addr;
+
+    assert(((u8 *) addr >= pool->start) && ((u8 *) addr < pool->start + (pool->blockSize * pool->numBlocks))
+           && ((((u8 *) addr - pool->start) % pool->blockSize) == 0), "Freed a block that isn't from this slab pool!");
+    block->next = pool->freeList;
+    pool->freeList = block;
+    pool->numUsed--;
 }
 
 void *alloc_display_list(u32 size) {
@@ -655,3 +1054,52 @@ s32 load_patchable_table(struct DmaHandlerList *list, s32 index) {
     }
     return FALSE;
 }
+
+#define ROM_CACHE_LINE_SIZE 256
+#define ROM_CACHE_NUM_LINES 4
+
+struct RomCacheLine {
+    uintptr_t romAddr; // 0 if the line is empty, since nothing is read from the ROM header.
+    u8 data[ROM_CACHE_LINE_SIZE] ALIGNED16;
+};
+
+static struct RomCacheLine sRomCache[ROM_CACHE_NUM_LINES];
+
+/**
+ * Mark a segment as ROM resident: it's never loaded into RAM, so segmented_to_virtual can't be used on it,
+ * and its data is read with rom_segment_read instead. The segment needs to be stored uncompressed.
+ */
+void set_segment_rom_resident(s32 segment, u8 *srcStart) {
+    sSegmentTable[segment] = 0;
+    sSegmentROMTable[segment] = (uintptr_t) srcStart;
+}
+
+/**
+ * Copy size bytes at the segmented address addr of a ROM resident segment to dest.
+ * Reads go through a small direct mapped cache of ROM_CACHE_LINE_SIZE byte lines, so reading
+ * a few small things that are close together (like a table entry and what it points to) costs one DMA.
+ */
+void rom_segment_read(void *dest, const void *addr, u32 size) {
+    uintptr_t romAddr = (sSegmentROMTable[(uintptr_t) addr >> 24] + ((uintptr_t) addr & 0x00FFFFFF));
+    u8 *destPtr = dest;
+
+    while (size != 0) {
+        uintptr_t lineAddr = (romAddr & ~(ROM_CACHE_LINE_SIZE - 1));
+        u32 lineOffset = (romAddr - lineAddr);
+        u32 copySize = (ROM_CACHE_LINE_SIZE - lineOffset);
+        struct RomCacheLine *line = &sRomCache[(lineAddr / ROM_CACHE_LINE_SIZE) % ROM_CACHE_NUM_LINES];
+
+        if (copySize > size) {
+            copySize = size;
+        }
+        if (line->romAddr != lineAddr) {
+            dma_read(line->data, (u8 *) lineAddr, (u8 *) lineAddr + ROM_CACHE_LINE_SIZE);
+            line->romAddr = lineAddr;
+        }
+        memcpy(destPtr, &line->data[lineOffset], copySize);
+
+        destPtr += copySize;
+        romAddr += copySize;
+        size -= copySize;
+    }
+}
@@ -0,0 +1,243 @@
+#include <PR/ultratypes.h>
+#include <string.h>
+
+#include "tlsf.h"
+
+/**
+ * Every block starts with a header holding the previous block in memory and its own size, which also has the
+ * TLSF_BLOCK_FREE flag. Free blocks also hold their neighbors in their free list, in the space that is handed
+ * out when they're allocated.
+ *
+ * The last header of the pool is a used block with a size of 0, so freed blocks never merge past the end.
+ */
+struct TlsfBlock {
+    struct TlsfBlock *prevPhys; // NULL for the first block.
+    u32 size;
+    struct TlsfBlock *nextFree;
+    struct TlsfBlock *prevFree;
+};
+
+#define TLSF_BLOCK_FREE        (1 << 0)
+#define TLSF_BLOCK_HEADER_SIZE ((u32) ((uintptr_t) &((struct TlsfBlock *) 0)->nextFree))
+#define TLSF_MIN_BLOCK_SIZE    ((u32) sizeof(struct TlsfBlock))
+#define TLSF_SMALL_BLOCK_SIZE  (1 << TLSF_FL_SHIFT)
+
+#define TLSF_ALIGN_UP(x)   (((x) + (TLSF_ALIGN - 1)) & ~(TLSF_ALIGN - 1))
+#define TLSF_ALIGN_DOWN(x) ((x) & ~(TLSF_ALIGN - 1))
+
+#define BLOCK_SIZE(block) ((block)->size & ~TLSF_BLOCK_FREE)
+#define BLOCK_NEXT(block) ((struct TlsfBlock *) ((u8 *) (block) + BLOCK_SIZE(block)))
+
+static s32 tlsf_fls(u32 x) {
+    return (31 - __builtin_clz(x));
+}
+
+static s32 tlsf_ffs(u32 x) {
+    return __builtin_ctz(x);
+}
+
+/**
+ * Get the free list a block of the given size belongs to.
+ */
+static void tlsf_mapping(u32 size, s32 *fl, s32 *sl) {
+    if (size < TLSF_SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (size >> TLSF_ALIGN_LOG2);
+    } else {
+        s32 msb = tlsf_fls(size);
+
+        *fl = (msb - (TLSF_FL_SHIFT - 1));
+        *sl = ((size >> (msb - TLSF_SL_COUNT_LOG2)) ^ TLSF_SL_COUNT);
+    }
+}
+
+static void tlsf_insert_free_block(struct TlsfPool *pool, struct TlsfBlock *block) {
+    s32 fl, sl;
+    tlsf_mapping(BLOCK_SIZE(block), &fl, &sl);
+    struct TlsfBlock *head = pool->freeLists[fl][sl];
+
+    block->nextFree = head;
+    block->prevFree = NULL;
+    if (head != NULL) {
+        head->prevFree = block;
+    }
+    pool->freeLists[fl][sl] = block;
+    pool->flBitmap |= (1 << fl);
+    pool->slBitmap[fl] |= (1 << sl);
+}
+
+static void tlsf_remove_free_block(struct TlsfPool *pool, struct TlsfBlock *block) {
+    s32 fl, sl;
+    tlsf_mapping(BLOCK_SIZE(block), &fl, &sl);
+
+    if (block->nextFree != NULL) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    if (block->prevFree != NULL) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        pool->freeLists[fl][sl] = block->nextFree;
+        if (block->nextFree == NULL) {
+            pool->slBitmap[fl] &= ~(1 << sl);
+            if (pool->slBitmap[fl] == 0) {
+                pool->flBitmap &= ~(1 << fl);
+            }
+        }
+    }
+}
+
+/**
+ * Find a free block of at least size bytes. The size is rounded up to the next free list first,
+ * so the head of any non-empty list at or above it is guaranteed to fit.
+ */
+static struct TlsfBlock *tlsf_find_free_block(struct TlsfPool *pool, u32 size) {
+    struct TlsfBlock *block;
+    u32 searchSize = size;
+    s32 fl, sl;
+
+    if (size >= TLSF_SMALL_BLOCK_SIZE) {
+        searchSize += ((1 << (tlsf_fls(size) - TLSF_SL_COUNT_LOG2)) - 1);
+    }
+    tlsf_mapping(searchSize, &fl, &sl);
+
+    if (fl < TLSF_FL_COUNT) {
+        u32 slMap = (pool->slBitmap[fl] & (~0U << sl));
+
+        if (slMap == 0) {
+            u32 flMap = (pool->flBitmap & (~0U << (fl + 1)));
+
+            if (flMap != 0) {
+                fl = tlsf_ffs(flMap);
+                slMap = pool->slBitmap[fl];
+            }
+        }
+        if (slMap != 0) {
+            return pool->freeLists[fl][tlsf_ffs(slMap)];
+        }
+    }
+
+    // Nothing is guaranteed to fit, but blocks in the request's own list might still be big enough.
+    tlsf_mapping(size, &fl, &sl);
+    for (block = pool->freeLists[fl][sl]; block != NULL; block = block->nextFree) {
+        if (BLOCK_SIZE(block) >= size) {
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Set up a pool covering size bytes starting at start.
+ */
+void tlsf_init(struct TlsfPool *pool, void *start, u32 size) {
+    u8 *alignedStart = (u8 *) TLSF_ALIGN_UP((uintptr_t) start);
+    struct TlsfBlock *block = (struct TlsfBlock *) alignedStart;
+    struct TlsfBlock *sentinel;
+
+    memset(pool, 0, sizeof(struct TlsfPool));
+
+    size = TLSF_ALIGN_DOWN(size - (u32) (alignedStart - (u8 *) start));
+    if (size < (TLSF_BLOCK_HEADER_SIZE + TLSF_MIN_BLOCK_SIZE)) {
+        return;
+    }
+
+    block->prevPhys = NULL;
+    block->size = (size - TLSF_BLOCK_HEADER_SIZE);
+    sentinel = BLOCK_NEXT(block);
+    sentinel->prevPhys = block;
+    sentinel->size = 0;
+
+    tlsf_insert_free_block(pool, block);
+    block->size |= TLSF_BLOCK_FREE;
+    pool->totalSpace = BLOCK_SIZE(block);
+}
+
+/**
+ * Allocate size bytes from the pool. Returns NULL if there is no free block large enough.
+ */
+void *tlsf_alloc(struct TlsfPool *pool, u32 size) {
+    u32 blockSize = TLSF_ALIGN_UP(size + TLSF_BLOCK_HEADER_SIZE);
+    struct TlsfBlock *block;
+
+    if (blockSize < TLSF_MIN_BLOCK_SIZE) {
+        blockSize = TLSF_MIN_BLOCK_SIZE;
+    }
+    if (blockSize >= TLSF_MAX_POOL_SIZE) {
+        return NULL;
+    }
+
+    block = tlsf_find_free_block(pool, blockSize);
+    if (block == NULL) {
+        return NULL;
+    }
+    tlsf_remove_free_block(pool, block);
+    block->size &= ~TLSF_BLOCK_FREE;
+
+    // Give whatever is left back to the pool, if it's enough for a block of its own.
+    if ((block->size - blockSize) >= TLSF_MIN_BLOCK_SIZE) {
+        struct TlsfBlock *rest = (struct TlsfBlock *) ((u8 *) block + blockSize);
+
+        rest->prevPhys = block;
+        rest->size = (block->size - blockSize);
+        BLOCK_NEXT(rest)->prevPhys = rest;
+        block->size = blockSize;
+
+        tlsf_insert_free_block(pool, rest);
+        rest->size |= TLSF_BLOCK_FREE;
+    }
+
+    pool->usedSpace += block->size;
+    if (pool->usedSpace > pool->highWater) {
+        pool->highWater = pool->usedSpace;
+    }
+
+    return ((u8 *) block + TLSF_BLOCK_HEADER_SIZE);
+}
+
+/**
+ * Free a block that was allocated with tlsf_alloc, merging it with the free blocks around it.
+ */
+void tlsf_free(struct TlsfPool *pool, void *addr) {
+    struct TlsfBlock *block = (struct TlsfBlock *) ((u8 *) addr - TLSF_BLOCK_HEADER_SIZE);
+    struct TlsfBlock *next = BLOCK_NEXT(block);
+    struct TlsfBlock *prev = block->prevPhys;
+
+    pool->usedSpace -= block->size;
+
+    if (next->size & TLSF_BLOCK_FREE) {
+        tlsf_remove_free_block(pool, next);
+        block->size += BLOCK_SIZE(next);
+        next = BLOCK_NEXT(block);
+        next->prevPhys = block;
+    }
+
+    if (prev != NULL && (prev->size & TLSF_BLOCK_FREE)) {
+        tlsf_remove_free_block(pool, prev);
+        prev->size = (BLOCK_SIZE(prev) + block->size);
+        next->prevPhys = prev;
+        block = prev;
+    }
+
+    tlsf_insert_free_block(pool, block);
+    block->size |= TLSF_BLOCK_FREE;
+}
+
+void tlsf_get_stats(struct TlsfPool *pool, struct TlsfStats *stats) {
+    stats->totalSpace = pool->totalSpace;
+    stats->usedSpace = pool->usedSpace;
+    stats->highWater = pool->highWater;
+    stats->largestFree = 0;
+
+    // The largest free block is in the highest non-empty list.
+    if (pool->flBitmap != 0) {
+        s32 fl = tlsf_fls(pool->flBitmap);
+        struct TlsfBlock *block;
+
+        for (block = pool->freeLists[fl][tlsf_fls(pool->slBitmap[fl])]; block != NULL; block = block->nextFree) {
+            if (BLOCK_SIZE(block) > stats->largestFree) {
+                stats->largestFree = BLOCK_SIZE(block);
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef TLSF_H
+#define TLSF_H
+
+#include <PR/ultratypes.h>
+
+/**
+ * Two level segregated fit allocator, used for the MemoryPools.
+ *
+ * Free blocks are kept in TLSF_FL_COUNT * TLSF_SL_COUNT lists by size: the first level splits sizes into powers
+ * of 2, and the second level splits each power of 2 into TLSF_SL_COUNT equal ranges. A bitmap of non-empty lists
+ * is kept for each level, so finding a free block that fits and freeing a block (merging it with its neighbors)
+ * both take constant time instead of walking a free list.
+ *
+ * This file doesn't depend on anything but ultratypes.h, so it can be built for the host by tools/mem_pool_bench.c.
+ */
+
+#define TLSF_SL_COUNT_LOG2 3
+#define TLSF_SL_COUNT      (1 << TLSF_SL_COUNT_LOG2)
+#define TLSF_ALIGN_LOG2    3
+#define TLSF_ALIGN         (1 << TLSF_ALIGN_LOG2)
+#define TLSF_FL_SHIFT      (TLSF_SL_COUNT_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT      16
+
+/**
+ * Pools must be smaller than this (2MB).
+ */
+#define TLSF_MAX_POOL_SIZE (1 << (TLSF_FL_COUNT + TLSF_FL_SHIFT - 1))
+
+struct TlsfBlock;
+
+struct TlsfPool {
+    u32 flBitmap;
+    u8 slBitmap[TLSF_FL_COUNT];
+    struct TlsfBlock *freeLists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    u32 totalSpace;
+    u32 usedSpace;
+    u32 highWater;
+};
+
+struct TlsfStats {
+    u32 totalSpace;  // Space available for blocks, including their headers.
+    u32 usedSpace;   // Space taken by allocated blocks, including their headers.
+    u32 highWater;   // The most usedSpace has ever been.
+    u32 largestFree; // The largest free block. Anything less than totalSpace - usedSpace means the pool is fragmented.
+};
+
+void tlsf_init(struct TlsfPool *pool, void *start, u32 size);
+void *tlsf_alloc(struct TlsfPool *pool, u32 size);
+void tlsf_free(struct TlsfPool *pool, void *addr);
+void tlsf_get_stats(struct TlsfPool *pool, struct TlsfStats *stats);
+
+#endif // TLSF_H
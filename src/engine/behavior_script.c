@@ -11,10 +11,14 @@
 #include "game/obj_behaviors_2.h"
 #include "game/object_helpers.h"
 #include "game/object_list_processor.h"
+#include "game/room_visibility.h"
 #include "math_util.h"
 #include "graph_node.h"
 #include "surface_collision.h"
 
+// How often objects with OBJ_FLAG_THROTTLE_IN_UNSEEN_ROOM update while their room can't be seen into.
+#define UNSEEN_ROOM_UPDATE_INTERVAL 4
+
 // Macros for retrieving arguments from behavior scripts.
 #define BHV_CMD_GET_1ST_U8(index)     (u8)((gCurBhvCommand[index] >> 24) & 0xFF) // unused
 #define BHV_CMD_GET_2ND_U8(index)     (u8)((gCurBhvCommand[index] >> 16) & 0xFF)
@@ -826,6 +830,14 @@ void cur_obj_update(void) {
         return;
     }
 
+    // Idle objects in rooms that can't be seen into only update every few frames,
+    // staggered by their slot in the object pool so they don't all update on the same frame.
+    if ((objFlags & OBJ_FLAG_THROTTLE_IN_UNSEEN_ROOM)
+        && !obj_is_in_visible_room(o)
+        && ((gGlobalTimer + (o - gObjectPool)) % UNSEEN_ROOM_UPDATE_INTERVAL) != 0) {
+        return;
+    }
+
     // Calculate the distance from the object to Mario.
     if (objFlags & OBJ_FLAG_COMPUTE_DIST_TO_MARIO) {
         o->oDistanceToMario = dist_between_objects(o, gMarioObject);
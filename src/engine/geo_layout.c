@@ -1,4 +1,5 @@
 #include <ultra64.h>
+#include <string.h>
 #include "sm64.h"
 
 #include "geo_layout.h"
@@ -6,6 +7,7 @@
 #include "game/memory.h"
 #include "graph_node.h"
 #include "game/debug.h"
+#include "game/room_visibility.h"
 
 typedef void (*GeoLayoutCommandProc)(void);
 
@@ -43,6 +45,9 @@ GeoLayoutCommandProc GeoLayoutJumpTable[] = {
     /*GEO_CMD_NOP_1E                    */ geo_layout_cmd_nop2,
     /*GEO_CMD_NOP_1F                    */ geo_layout_cmd_nop3,
     /*GEO_CMD_NODE_CULLING_RADIUS       */ geo_layout_cmd_node_culling_radius,
+    /*GEO_CMD_NODE_CULLING_BOUNDS       */ geo_layout_cmd_node_culling_bounds,
+    /*GEO_CMD_NODE_ROOM                 */ geo_layout_cmd_node_room,
+    /*GEO_CMD_ROOM_PORTAL               */ geo_layout_cmd_room_portal,
 };
 
 struct GraphNode gObjParentGraphNode;
@@ -106,6 +111,7 @@ void geo_layout_cmd_branch_and_link(void) {
     gGeoLayoutStack[gGeoLayoutStackIndex++] = (uintptr_t) (gGeoLayoutCommand + CMD_PROCESS_OFFSET(8));
     gGeoLayoutStack[gGeoLayoutStackIndex++] = (gCurGraphNodeIndex << 16) + gGeoLayoutReturnIndex;
     gGeoLayoutReturnIndex = gGeoLayoutStackIndex;
+    geo_layout_cache_check_branch(cur_geo_cmd_ptr(0x04));
     gGeoLayoutCommand = segmented_to_virtual(cur_geo_cmd_ptr(0x04));
 }
 
@@ -126,6 +132,7 @@ void geo_layout_cmd_branch(void) {
         gGeoLayoutStack[gGeoLayoutStackIndex++] = (uintptr_t) (gGeoLayoutCommand + CMD_PROCESS_OFFSET(8));
     }
 
+    geo_layout_cache_check_branch(cur_geo_cmd_ptr(0x04));
     gGeoLayoutCommand = segmented_to_virtual(cur_geo_cmd_ptr(0x04));
 }
 
@@ -763,7 +770,211 @@ void geo_layout_cmd_node_culling_radius(void) {
     gGeoLayoutCommand += 0x04 << CMD_SIZE_SHIFT;
 }
 
+/*
+  0x21: Create a scene graph node that only renders its children when the
+   bounding box around them is in view.
+   cmd+0x04: Vec3s min
+   cmd+0x0A: Vec3s max
+*/
+void geo_layout_cmd_node_culling_bounds(void) {
+    struct GraphNodeCullingBounds *graphNode;
+    Vec3s min, max;
+
+    read_vec3s(min, (s16 *) &gGeoLayoutCommand[0x04]);
+    read_vec3s(max, (s16 *) &gGeoLayoutCommand[0x0A]);
+
+    graphNode = init_graph_node_culling_bounds(gGraphNodePool, NULL, min, max);
+    register_scene_graph_node(&graphNode->node);
+    gGeoLayoutCommand += 0x10 << CMD_SIZE_SHIFT;
+}
+
+/*
+  0x22: Create a scene graph node that only renders its children while its room is visible.
+   cmd+0x02: s16 room
+*/
+void geo_layout_cmd_node_room(void) {
+    struct GraphNodeRoom *graphNode = init_graph_node_room(gGraphNodePool, NULL, cur_geo_cmd_s16(0x02));
+    register_scene_graph_node(&graphNode->node);
+    gGeoLayoutCommand += 0x04 << CMD_SIZE_SHIFT;
+}
+
+/*
+  0x23: Declare a portal between two rooms. Doesn't create a node.
+   cmd+0x02: s16 roomA
+   cmd+0x04: s16 roomB
+*/
+void geo_layout_cmd_room_portal(void) {
+    room_visibility_add_portal(ROOM_PORTAL_LOADING_AREA, cur_geo_cmd_s16(0x02), cur_geo_cmd_s16(0x04));
+    gGeoLayoutCommand += 0x08 << CMD_SIZE_SHIFT;
+}
+
+#ifdef GEO_LAYOUT_CACHE
+/**
+ * Model graphs built from geo layouts, stored exactly as they were laid out in the pool they were built in.
+ * The AllocOnlyPool hands out memory linearly and nodes are created in the order they're traversed,
+ * so each graph is a single depth-first block that can be copied to a new pool and relocated.
+ */
+struct GeoLayoutCacheEntry {
+    /*0x00*/ uintptr_t romAddr;   // ROM address of the geo layout, which identifies it between loads
+    /*0x04*/ u8 *image;           // copy of the block the graph was built in
+    /*0x08*/ uintptr_t imageBase; // address the graph was built at, which its pointers are relative to
+    /*0x0C*/ u16 size;
+    /*0x0E*/ u16 rootOffset;
+}; /*0x10*/
+
+static struct GeoLayoutCacheEntry sGeoLayoutCache[GEO_LAYOUT_CACHE_ENTRIES];
+static u8 sGeoLayoutCacheBuffer[GEO_LAYOUT_CACHE_SIZE] ALIGNED8;
+static s32 sGeoLayoutCacheCount = 0;
+static u32 sGeoLayoutCacheUsed = 0;
+
+// The segment of the geo layout currently being processed, and whether the result can be cached.
+static uintptr_t sGeoLayoutSegment;
+static u8 sGeoLayoutCacheable;
+
+/**
+ * Returns the ROM address of a geo layout, or 0 if it isn't in a segment loaded from ROM.
+ */
+static uintptr_t geo_layout_cache_rom_addr(void *segptr) {
+    uintptr_t segment = ((uintptr_t) segptr >> 24);
+    uintptr_t romAddr;
+
+    if (segment >= 32) {
+        return 0;
+    }
+
+    romAddr = get_segment_rom_addr(segment);
+    if (romAddr == 0) {
+        return 0;
+    }
+
+    return (romAddr + ((uintptr_t) segptr & 0x00FFFFFF));
+}
+
+/**
+ * Geo layouts that branch into another segment depend on what that segment
+ * currently holds, so they can't be identified by their own ROM address alone.
+ */
+void geo_layout_cache_check_branch(void *segptr) {
+    if (((uintptr_t) segptr >> 24) != sGeoLayoutSegment) {
+        sGeoLayoutCacheable = FALSE;
+    }
+}
+
+/**
+ * Only graphs whose nodes don't point anywhere except other nodes of the same graph can be cached.
+ */
+static s32 geo_layout_cache_graph_is_relocatable(struct GraphNode *firstNode) {
+    struct GraphNode *node = firstNode;
+
+    do {
+        switch (node->type) {
+            case GRAPH_NODE_TYPE_ROOT:
+            case GRAPH_NODE_TYPE_ORTHO_PROJECTION:
+            case GRAPH_NODE_TYPE_PERSPECTIVE:
+            case GRAPH_NODE_TYPE_MASTER_LIST:
+            case GRAPH_NODE_TYPE_CAMERA:
+            case GRAPH_NODE_TYPE_OBJECT:
+            case GRAPH_NODE_TYPE_OBJECT_PARENT:
+            case GRAPH_NODE_TYPE_BACKGROUND:
+                return FALSE;
+        }
+
+        if (node->children != NULL && !geo_layout_cache_graph_is_relocatable(node->children)) {
+            return FALSE;
+        }
+    } while ((node = node->next) != firstNode);
+
+    return TRUE;
+}
+
+#define RELOCATE_NODE_PTR(ptr, offset) if ((ptr) != NULL) { (ptr) = (void *) ((uintptr_t) (ptr) + (offset)); }
+
+static void geo_layout_cache_relocate_graph(struct GraphNode *firstNode, uintptr_t offset) {
+    struct GraphNode *node = firstNode;
+
+    do {
+        RELOCATE_NODE_PTR(node->prev, offset);
+        RELOCATE_NODE_PTR(node->next, offset);
+        RELOCATE_NODE_PTR(node->parent, offset);
+        RELOCATE_NODE_PTR(node->children, offset);
+
+        if (node->children != NULL) {
+            geo_layout_cache_relocate_graph(node->children, offset);
+        }
+    } while ((node = node->next) != firstNode);
+}
+
+#undef RELOCATE_NODE_PTR
+
+/**
+ * Copies a cached graph into the pool and returns its root, or NULL if the geo layout isn't cached.
+ */
+static struct GraphNode *geo_layout_cache_load(struct AllocOnlyPool *pool, uintptr_t romAddr) {
+    struct GeoLayoutCacheEntry *entry;
+    struct GraphNode *root;
+    u8 *dest;
+    s32 i;
+
+    for (i = 0; i < sGeoLayoutCacheCount; i++) {
+        entry = &sGeoLayoutCache[i];
+        if (entry->romAddr != romAddr) {
+            continue;
+        }
+
+        dest = alloc_only_pool_alloc(pool, entry->size);
+        if (dest == NULL) {
+            return NULL;
+        }
+
+        memcpy(dest, entry->image, entry->size);
+        root = (struct GraphNode *) (dest + entry->rootOffset);
+        // The root's parent gets set by whoever attaches the graph, so only the
+        // root's siblings and descendants need to be relocated.
+        geo_layout_cache_relocate_graph(root, ((uintptr_t) dest - entry->imageBase));
+        return root;
+    }
+
+    return NULL;
+}
+
+static void geo_layout_cache_store(uintptr_t romAddr, u8 *start, u8 *end, struct GraphNode *root) {
+    struct GeoLayoutCacheEntry *entry;
+    u32 size = (end - start);
+
+    if (root == NULL
+        || sGeoLayoutCacheCount >= GEO_LAYOUT_CACHE_ENTRIES
+        || sGeoLayoutCacheUsed + size > sizeof(sGeoLayoutCacheBuffer)
+        || !geo_layout_cache_graph_is_relocatable(root)) {
+        return;
+    }
+
+    entry = &sGeoLayoutCache[sGeoLayoutCacheCount++];
+    entry->romAddr = romAddr;
+    entry->image = &sGeoLayoutCacheBuffer[sGeoLayoutCacheUsed];
+    entry->imageBase = (uintptr_t) start;
+    entry->size = size;
+    entry->rootOffset = ((u8 *) root - start);
+
+    memcpy(entry->image, start, size);
+    sGeoLayoutCacheUsed += ALIGN8(size);
+}
+#endif
+
 struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr) {
+#ifdef GEO_LAYOUT_CACHE
+    uintptr_t romAddr = geo_layout_cache_rom_addr(segptr);
+    u8 *poolStart = pool->freePtr;
+
+    if (romAddr != 0) {
+        struct GraphNode *cachedRoot = geo_layout_cache_load(pool, romAddr);
+        if (cachedRoot != NULL) {
+            return cachedRoot;
+        }
+    }
+
+    sGeoLayoutSegment = ((uintptr_t) segptr >> 24);
+    sGeoLayoutCacheable = (romAddr != 0);
+#endif
     // set by register_scene_graph_node when gCurGraphNodeIndex is 0
     // and gCurRootGraphNode is NULL
     gCurRootGraphNode = NULL;
@@ -788,5 +999,11 @@ struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr) {
         GeoLayoutJumpTable[gGeoLayoutCommand[0x00]]();
     }
 
+#ifdef GEO_LAYOUT_CACHE
+    if (sGeoLayoutCacheable) {
+        geo_layout_cache_store(romAddr, poolStart, pool->freePtr, gCurRootGraphNode);
+    }
+#endif
+
     return gCurRootGraphNode;
 }
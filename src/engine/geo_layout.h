@@ -82,7 +82,16 @@ void geo_layout_cmd_nop(void);
 void geo_layout_cmd_copy_view(void);
 void geo_layout_cmd_node_held_obj(void);
 void geo_layout_cmd_node_culling_radius(void);
+void geo_layout_cmd_node_culling_bounds(void);
+void geo_layout_cmd_node_room(void);
+void geo_layout_cmd_room_portal(void);
 
 struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr);
 
+#ifdef GEO_LAYOUT_CACHE
+void geo_layout_cache_check_branch(void *segptr);
+#else
+#define geo_layout_cache_check_branch(segptr)
+#endif
+
 #endif // GEO_LAYOUT_H
@@ -334,6 +334,42 @@ struct GraphNodeCullingRadius *init_graph_node_culling_radius(struct AllocOnlyPo
     return graphNode;
 }
 
+/**
+ * Allocates and returns a newly created culling bounds node
+ */
+struct GraphNodeCullingBounds *init_graph_node_culling_bounds(struct AllocOnlyPool *pool,
+                                                              struct GraphNodeCullingBounds *graphNode,
+                                                              Vec3s min, Vec3s max) {
+    if (pool != NULL) {
+        graphNode = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeCullingBounds));
+    }
+
+    if (graphNode != NULL) {
+        init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_CULLING_BOUNDS);
+        vec3s_copy(graphNode->min, min);
+        vec3s_copy(graphNode->max, max);
+    }
+
+    return graphNode;
+}
+
+/**
+ * Allocates and returns a newly created room node
+ */
+struct GraphNodeRoom *init_graph_node_room(struct AllocOnlyPool *pool, struct GraphNodeRoom *graphNode,
+                                           RoomData room) {
+    if (pool != NULL) {
+        graphNode = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeRoom));
+    }
+
+    if (graphNode != NULL) {
+        init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_ROOM);
+        graphNode->room = room;
+    }
+
+    return graphNode;
+}
+
 /**
  * Allocates and returns a newly created animated part node
  */
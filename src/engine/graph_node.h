@@ -65,6 +65,8 @@ enum GraphNodeTypes {
     GRAPH_NODE_TYPE_CULLING_RADIUS,
     GRAPH_NODE_TYPE_ROOT,
     GRAPH_NODE_TYPE_START,
+    GRAPH_NODE_TYPE_CULLING_BOUNDS,
+    GRAPH_NODE_TYPE_ROOM,
 };
 
 // Passed as first argument to a GraphNodeFunc to give information about in
@@ -351,6 +353,25 @@ struct GraphNodeCullingRadius {
     // u8 filler[2];
 };
 
+/** GraphNode that only renders its children if a bounding box around them is in view.
+ *  Used to split large level geometry into chunks, so chunks that are off screen
+ *  aren't sent to the RSP. The box is in the node's local space.
+ */
+struct GraphNodeCullingBounds {
+    /*0x00*/ struct GraphNode node;
+    /*0x14*/ Vec3s min;
+    /*0x1A*/ Vec3s max;
+}; /*0x20*/
+
+/** GraphNode that only renders its children while its room is visible
+ *  from the camera's room. See room_visibility.c.
+ */
+struct GraphNodeRoom {
+    /*0x00*/ struct GraphNode node;
+    /*0x14*/ RoomData room;
+    // u8 filler[3];
+};
+
 extern struct GraphNodeMasterList  *gCurGraphNodeMasterList;
 extern struct GraphNodePerspective *gCurGraphNodeCamFrustum;
 extern struct GraphNodeCamera      *gCurGraphNodeCamera;
@@ -379,6 +400,8 @@ struct GraphNodeRotation            *init_graph_node_rotation            (struct
 struct GraphNodeScale               *init_graph_node_scale               (struct AllocOnlyPool *pool, struct GraphNodeScale               *graphNode, s32 drawingLayer, void *displayList, f32 scale);
 struct GraphNodeObject              *init_graph_node_object              (struct AllocOnlyPool *pool, struct GraphNodeObject              *graphNode, struct GraphNode *sharedChild, Vec3f pos, Vec3s angle, Vec3f scale);
 struct GraphNodeCullingRadius       *init_graph_node_culling_radius      (struct AllocOnlyPool *pool, struct GraphNodeCullingRadius       *graphNode, s16 radius);
+struct GraphNodeCullingBounds       *init_graph_node_culling_bounds      (struct AllocOnlyPool *pool, struct GraphNodeCullingBounds       *graphNode, Vec3s min, Vec3s max);
+struct GraphNodeRoom                *init_graph_node_room                (struct AllocOnlyPool *pool, struct GraphNodeRoom                *graphNode, RoomData room);
 struct GraphNodeAnimatedPart        *init_graph_node_animated_part       (struct AllocOnlyPool *pool, struct GraphNodeAnimatedPart        *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
 struct GraphNodeBillboard           *init_graph_node_billboard           (struct AllocOnlyPool *pool, struct GraphNodeBillboard           *graphNode, s32 drawingLayer, void *displayList, Vec3s translation, Vec3s axis, u8 isCylindrical);
 struct GraphNodeDisplayList         *init_graph_node_display_list        (struct AllocOnlyPool *pool, struct GraphNodeDisplayList         *graphNode, s32 drawingLayer, void *displayList);
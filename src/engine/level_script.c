@@ -30,6 +30,7 @@
 #include "game/puppycam2.h"
 #include "game/puppyprint.h"
 #include "game/emutest.h"
+#include "game/room_visibility.h"
 
 #include "config.h"
 
@@ -293,7 +294,31 @@ static void level_cmd_load_raw(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+#ifdef STREAM_LEVEL_SEGMENTS
+// Segments that aren't needed to draw the level itself, so gameplay can start before they're decompressed.
+#define STREAMED_SEGMENTS ((1 << SEGMENT_GROUPA_YAY0) | (1 << SEGMENT_GROUPB_YAY0) | (1 << SEGMENT_COMMON0_YAY0))
+#endif
+
+#ifdef SEGMENT_CACHE
+// Segments that are never written to at runtime, so they can be kept in the segment cache between loads.
+#define CACHED_SEGMENTS ((1 << SEGMENT_GROUPA_YAY0) | (1 << SEGMENT_GROUPB_YAY0) | (1 << SEGMENT_COMMON0_YAY0) | (1 << SEGMENT_SKYBOX))
+#endif
+
 static void level_cmd_load_yay0(void) {
+#ifdef STREAM_LEVEL_SEGMENTS
+    if (STREAMED_SEGMENTS & (1 << CMD_GET(s16, 2))) {
+        load_segment_decompress_streamed(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8));
+        sCurrentCmd = CMD_NEXT;
+        return;
+    }
+#endif
+#ifdef SEGMENT_CACHE
+    if (CACHED_SEGMENTS & (1 << CMD_GET(s16, 2))) {
+        load_segment_decompress_cached(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8));
+        sCurrentCmd = CMD_NEXT;
+        return;
+    }
+#endif
     load_segment_decompress(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8));
     sCurrentCmd = CMD_NEXT;
 }
@@ -411,10 +436,14 @@ static void level_cmd_begin_area(void) {
     void *geoLayoutAddr = CMD_GET(void *, 4);
 
     if (areaIndex < AREA_COUNT) {
+        room_visibility_set_loading_area(areaIndex);
+
         struct GraphNodeRoot *screenArea =
             (struct GraphNodeRoot *) process_geo_layout(sLevelPool, geoLayoutAddr);
         struct GraphNodeCamera *node = (struct GraphNodeCamera *) screenArea->views[0];
 
+        room_visibility_set_loading_area(ROOM_PORTAL_NO_AREA);
+
         sCurrAreaIndex = areaIndex;
         screenArea->areaIndex = areaIndex;
         gAreas[areaIndex].graphNode = screenArea;
@@ -849,6 +878,8 @@ static void level_cmd_puppyvolume(void) {
                                                             CMD_GET(s16, 12));
 
     sPuppyVolumeStack[gPuppyVolumeCount]->rot = CMD_GET(s16, 14);
+    sPuppyVolumeStack[gPuppyVolumeCount]->sinRot = sins(CMD_GET(s16, 14));
+    sPuppyVolumeStack[gPuppyVolumeCount]->cosRot = coss(CMD_GET(s16, 14));
 
     sPuppyVolumeStack[gPuppyVolumeCount]->func   = CMD_GET(void *, 16);
     sPuppyVolumeStack[gPuppyVolumeCount]->angles = segmented_to_virtual(CMD_GET(void *, 20));
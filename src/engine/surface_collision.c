@@ -9,6 +9,7 @@
 #include "surface_collision.h"
 #include "surface_load.h"
 #include "game/puppyprint.h"
+#include "game/event_trace.h"
 
 /**************************************************
  *                      WALLS                     *
@@ -586,6 +587,7 @@ f32 unused_find_dynamic_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfl
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
     PUPPYPRINT_GET_SNAPSHOT();
+    TRACE_TIMER_START(traceStart);
 
     f32 height        = FLOOR_LOWER_LIMIT;
     f32 dynamicHeight = FLOOR_LOWER_LIMIT;
@@ -601,6 +603,7 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
 
     if (is_outside_level_bounds(x, z)) {
         profiler_collision_update(first);
+        TRACE_ADD_TOTAL(TRACE_EVENT_FIND_FLOOR, traceStart);
         return height;
     }
     // Each level is split into cells to limit load, find the appropriate cell.
@@ -647,6 +650,7 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
 #endif
 
     profiler_collision_update(first);
+    TRACE_ADD_TOTAL(TRACE_EVENT_FIND_FLOOR, traceStart);
     return height;
 }
 
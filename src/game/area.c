@@ -7,6 +7,7 @@
 #include "behavior_data.h"
 #include "game_init.h"
 #include "object_list_processor.h"
+#include "lazy_spawn.h"
 #include "engine/surface_load.h"
 #include "ingame_menu.h"
 #include "screen_transition.h"
@@ -238,6 +239,8 @@ void load_area(s32 index) {
 
         gMarioCurrentRoom = 0;
 
+        lazy_spawn_reset();
+
         if (gCurrentArea->surfaceRooms != NULL) {
             bzero(gDoorAdjacentRooms, sizeof(gDoorAdjacentRooms));
         }
@@ -276,7 +279,7 @@ void load_mario_area(void) {
     }
 
     if (gAreaSkyboxStart[gCurrAreaIndex - 1]) {
-        load_segment_decompress(SEGMENT_SKYBOX, gAreaSkyboxStart[gCurrAreaIndex - 1], gAreaSkyboxEnd[gCurrAreaIndex - 1]);
+        load_segment_decompress_cached(SEGMENT_SKYBOX, gAreaSkyboxStart[gCurrAreaIndex - 1], gAreaSkyboxEnd[gCurrAreaIndex - 1]);
     }
 }
 
@@ -0,0 +1,158 @@
+#include <ultra64.h>
+#include <string.h>
+
+#include "sm64.h"
+#include "behavior_profiler.h"
+#include "printf.h"
+#ifdef UNF
+#include "usb/usb.h"
+#endif
+
+#ifdef BEHAVIOR_PROFILER
+
+// The window being recorded, and a copy of the last complete one.
+static struct BehaviorProfile sBehaviorProfiles[BEHAVIOR_PROFILER_TABLE_SIZE];
+static struct BehaviorProfile sOtherProfile;
+static struct BehaviorProfile sLastBehaviorProfiles[BEHAVIOR_PROFILER_TABLE_SIZE];
+static struct BehaviorProfile sLastOtherProfile;
+
+// The slowest behaviors of the last complete window, averaged per frame.
+static struct BehaviorProfile sTopBehaviorProfiles[BEHAVIOR_PROFILER_TOP_COUNT];
+static s32 sNumTopBehaviorProfiles = 0;
+
+static u32 sBehaviorProfilerFrames = 0;
+static const BehaviorScript *sCurrentBehavior = NULL;
+static u32 sCurrentBehaviorStart = 0;
+
+static u32 hash_behavior(const BehaviorScript *behavior) {
+    return ((((uintptr_t) behavior >> 2) * 2654435761U) >> (32 - BEHAVIOR_PROFILER_TABLE_BITS));
+}
+
+/**
+ * Find the table entry for a behavior, claiming a free one if it isn't in the table yet.
+ */
+static struct BehaviorProfile *get_behavior_profile(const BehaviorScript *behavior) {
+    u32 index = hash_behavior(behavior);
+    s32 i;
+
+    for (i = 0; i < BEHAVIOR_PROFILER_TABLE_SIZE; i++) {
+        struct BehaviorProfile *profile = &sBehaviorProfiles[index];
+
+        if (profile->behavior == behavior) {
+            return profile;
+        }
+        if (profile->behavior == NULL) {
+            profile->behavior = behavior;
+            return profile;
+        }
+        index = ((index + 1) & (BEHAVIOR_PROFILER_TABLE_SIZE - 1));
+    }
+
+    return &sOtherProfile;
+}
+
+void behavior_profiler_begin(const BehaviorScript *behavior) {
+    sCurrentBehavior = behavior;
+    sCurrentBehaviorStart = osGetCount();
+}
+
+void behavior_profiler_end(void) {
+    struct BehaviorProfile *profile = get_behavior_profile(sCurrentBehavior);
+
+    profile->cycles += (osGetCount() - sCurrentBehaviorStart);
+    profile->calls++;
+}
+
+/**
+ * Insert a profile into the top list if it's slow enough, keeping the list sorted from slowest to fastest.
+ */
+static void insert_top_behavior_profile(struct BehaviorProfile *profile) {
+    s32 i;
+
+    if (profile->calls == 0) {
+        return;
+    }
+
+    for (i = sNumTopBehaviorProfiles; i > 0; i--) {
+        if (sTopBehaviorProfiles[i - 1].cycles >= profile->cycles) {
+            break;
+        }
+        if (i < BEHAVIOR_PROFILER_TOP_COUNT) {
+            sTopBehaviorProfiles[i] = sTopBehaviorProfiles[i - 1];
+        }
+    }
+
+    if (i < BEHAVIOR_PROFILER_TOP_COUNT) {
+        sTopBehaviorProfiles[i] = *profile;
+        if (sNumTopBehaviorProfiles < BEHAVIOR_PROFILER_TOP_COUNT) {
+            sNumTopBehaviorProfiles++;
+        }
+    }
+}
+
+/**
+ * Called once per frame. At the end of each window, the top list is rebuilt and the table is cleared.
+ */
+void behavior_profiler_update(void) {
+    s32 i;
+
+    if (++sBehaviorProfilerFrames < BEHAVIOR_PROFILER_WINDOW) {
+        return;
+    }
+
+    sNumTopBehaviorProfiles = 0;
+    for (i = 0; i < BEHAVIOR_PROFILER_TABLE_SIZE; i++) {
+        insert_top_behavior_profile(&sBehaviorProfiles[i]);
+    }
+    insert_top_behavior_profile(&sOtherProfile);
+
+    for (i = 0; i < sNumTopBehaviorProfiles; i++) {
+        sTopBehaviorProfiles[i].cycles /= sBehaviorProfilerFrames;
+        sTopBehaviorProfiles[i].calls  /= sBehaviorProfilerFrames;
+    }
+
+    memcpy(sLastBehaviorProfiles, sBehaviorProfiles, sizeof(sBehaviorProfiles));
+    sLastOtherProfile = sOtherProfile;
+    bzero(sBehaviorProfiles, sizeof(sBehaviorProfiles));
+    bzero(&sOtherProfile, sizeof(sOtherProfile));
+    sBehaviorProfilerFrames = 0;
+}
+
+/**
+ * Returns the index'th slowest behavior of the last window, or NULL if there aren't that many.
+ */
+struct BehaviorProfile *behavior_profiler_get_top(s32 index) {
+    if (index >= sNumTopBehaviorProfiles) {
+        return NULL;
+    }
+
+    return &sTopBehaviorProfiles[index];
+}
+
+#ifdef UNF
+static char sBehaviorProfilerDump[32 * (BEHAVIOR_PROFILER_TABLE_SIZE + 2)];
+#endif
+
+/**
+ * Send every behavior of the last window over USB, unsorted.
+ */
+void behavior_profiler_dump(void) {
+#ifdef UNF
+    struct BehaviorProfile *profile = sLastBehaviorProfiles;
+    s32 len = sprintf(sBehaviorProfilerDump, "behavior,cycles,calls\n");
+    s32 i;
+
+    for (i = 0; i < BEHAVIOR_PROFILER_TABLE_SIZE; i++, profile++) {
+        if (profile->calls != 0) {
+            len += sprintf(&sBehaviorProfilerDump[len], "%08X,%u,%u\n", (u32) profile->behavior, profile->cycles, profile->calls);
+        }
+    }
+    if (sLastOtherProfile.calls != 0) {
+        len += sprintf(&sBehaviorProfilerDump[len], "other,%u,%u\n", sLastOtherProfile.cycles, sLastOtherProfile.calls);
+    }
+
+    usb_write(DATATYPE_TEXT, sBehaviorProfilerDump, len);
+#endif
+}
+
+#endif // BEHAVIOR_PROFILER
@@ -0,0 +1,49 @@
+#ifndef BEHAVIOR_PROFILER_H
+#define BEHAVIOR_PROFILER_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * Per behavior CPU profiler.
+ *
+ * The time spent in every object's cur_obj_update is added up per behavior script over
+ * BEHAVIOR_PROFILER_WINDOW frames. At the end of each window, the behaviors that took the most
+ * time are shown on the "Behaviors" puppyprint page, averaged per frame.
+ *
+ * Behaviors are identified by the address of their script, which can be looked up in the build's map file.
+ * With UNF, pressing A on the page sends the whole last window with usb_write(DATATYPE_TEXT)
+ * as CSV lines of "behavior,cycles,calls", where cycles and calls are totals over the window.
+ */
+
+/**
+ * The number of distinct behaviors that can be tracked at once. Must be a power of 2.
+ * Anything past that is added up as "Other".
+ */
+#define BEHAVIOR_PROFILER_TABLE_BITS 7
+#define BEHAVIOR_PROFILER_TABLE_SIZE (1 << BEHAVIOR_PROFILER_TABLE_BITS)
+
+#define BEHAVIOR_PROFILER_WINDOW 30
+#define BEHAVIOR_PROFILER_TOP_COUNT 10
+
+struct BehaviorProfile {
+    /*0x00*/ const BehaviorScript *behavior; // NULL for the "Other" entry.
+    /*0x04*/ u32 cycles;
+    /*0x08*/ u32 calls;
+}; /*0x0C*/
+
+#ifdef BEHAVIOR_PROFILER
+void behavior_profiler_begin(const BehaviorScript *behavior);
+void behavior_profiler_end(void);
+void behavior_profiler_update(void);
+struct BehaviorProfile *behavior_profiler_get_top(s32 index);
+void behavior_profiler_dump(void);
+#else
+#define behavior_profiler_begin(behavior)
+#define behavior_profiler_end()
+#define behavior_profiler_update()
+#define behavior_profiler_dump()
+#endif
+
+#endif // BEHAVIOR_PROFILER_H
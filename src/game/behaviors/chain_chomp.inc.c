@@ -14,6 +14,9 @@
 #define CHAIN_CHOMP_LOAD_DIST   (3000.0f + (CHAIN_CHOMP_NUM_SEGMENTS * CHAIN_CHOMP_CHAIN_MAX_DIST_BETWEEN_PARTS))
 #define CHAIN_CHOMP_UNLOAD_DIST (4000.0f + (CHAIN_CHOMP_NUM_SEGMENTS * CHAIN_CHOMP_CHAIN_MAX_DIST_BETWEEN_PARTS))
 
+STATIC_ASSERT((CHAIN_CHOMP_NUM_SEGMENTS * sizeof(struct ChainSegment)) <= OBJECT_SIDECAR_SIZE,
+              "The chain chomp's chain doesn't fit in an object sidecar, raise OBJECT_SIDECAR_SIZE!");
+
 /**
  * Hitbox for chain chomp.
  */
@@ -54,7 +57,7 @@ static void chain_chomp_act_uninitialized(void) {
     s32 i;
 
     if (o->oDistanceToMario < CHAIN_CHOMP_LOAD_DIST) {
-        segments = mem_pool_alloc(gObjectMemoryPool, CHAIN_CHOMP_NUM_SEGMENTS * sizeof(struct ChainSegment));
+        segments = obj_alloc_sidecar_array(o, struct ChainSegment, CHAIN_CHOMP_NUM_SEGMENTS);
         if (segments != NULL) {
             // Each segment represents the offset of a chain part to the pivot.
             // Segment 0 connects the pivot to the chain chomp itself. Segment
@@ -403,7 +406,7 @@ static void chain_chomp_act_move(void) {
  */
 static void chain_chomp_act_unload_chain(void) {
     cur_obj_hide();
-    mem_pool_free(gObjectMemoryPool, o->oChainChompSegments);
+    obj_free_sidecar(o);
 
     o->oAction = CHAIN_CHOMP_ACT_UNINITIALIZED;
 
@@ -7,6 +7,9 @@
  * Processing order is bhvWigglerHead, then bhvWigglerBody 1, 2, then 3.
  */
 
+STATIC_ASSERT((WIGGLER_NUM_SEGMENTS * sizeof(struct ChainSegment)) <= OBJECT_SIDECAR_SIZE,
+              "Wiggler's segments don't fit in an object sidecar, raise OBJECT_SIDECAR_SIZE!");
+
 /**
  * Hitbox for wiggler's non-head body parts.
  */
@@ -111,7 +114,7 @@ void bhv_wiggler_body_part_update(void) {
 void wiggler_init_segments(void) {
     s32 i;
     struct Object *bodyPart;
-    struct ChainSegment *segments = mem_pool_alloc(gObjectMemoryPool, WIGGLER_NUM_SEGMENTS * sizeof(struct ChainSegment));
+    struct ChainSegment *segments = obj_alloc_sidecar_array(o, struct ChainSegment, WIGGLER_NUM_SEGMENTS);
 
     if (segments != NULL) {
         // Each segment represents the global position and orientation of each
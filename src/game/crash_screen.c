@@ -11,6 +11,7 @@
 #include "main.h"
 #include "debug.h"
 #include "rumble_init.h"
+#include "event_trace.h"
 
 #include "sm64.h"
 
@@ -22,6 +23,9 @@ enum crashPages {
     PAGE_CONTEXT,
 #ifdef PUPPYPRINT_DEBUG
     PAGE_LOG,
+#endif
+#ifdef EVENT_TRACER
+    PAGE_EVENT_TRACE,
 #endif
     PAGE_STACKTRACE,
     PAGE_DISASM,
@@ -285,6 +289,33 @@ void draw_crash_log(void) {
 }
 #endif
 
+#ifdef EVENT_TRACER
+static const char *sTracePhaseNames[] = {
+    [TRACE_PHASE_BEGIN] = "B",
+    [TRACE_PHASE_END  ] = "E",
+    [TRACE_PHASE_TOTAL] = "T",
+};
+
+// prints the most recent events recorded by the event tracer, newest first
+void draw_event_trace(void) {
+    struct TraceEvent *event;
+    s32 i;
+
+    crash_screen_draw_rect(25, 20, 270, 210);
+    crash_screen_print(30, 25, "EVENT TRACE:");
+    osWritebackDCacheAll();
+
+    for (i = 0; i < 19; i++) {
+        event = event_trace_get_recent(i);
+        if (event == NULL) {
+            break;
+        }
+
+        crash_screen_print(30, (35 + (i * 10)), "%08X T%d %s %08X %s", event->timestamp, event->thread,
+                           sTracePhaseNames[event->phase], event->arg, event_trace_get_name(event->id));
+    }
+}
+#endif
 
 // prints any function pointers it finds in the stack format:
 // SP address: function name
@@ -403,6 +434,9 @@ void draw_crash_screen(OSThread *thread) {
             case PAGE_CONTEXT:    draw_crash_context(thread, cause); break;
 #ifdef PUPPYPRINT_DEBUG
             case PAGE_LOG: 		  draw_crash_log(); break;
+#endif
+#ifdef EVENT_TRACER
+            case PAGE_EVENT_TRACE: draw_event_trace(); break;
 #endif
             case PAGE_STACKTRACE: draw_stacktrace(thread, cause); break;
             case PAGE_DISASM:     draw_disasm(thread); break;
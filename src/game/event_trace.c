@@ -0,0 +1,131 @@
+#include <ultra64.h>
+#include <PR/os_internal_reg.h>
+#include <string.h>
+
+#include "sm64.h"
+#include "event_trace.h"
+#ifdef UNF
+#include "usb/usb.h"
+#endif
+
+#ifdef EVENT_TRACER
+
+#if (EVENT_TRACE_BUFFER_SIZE & (EVENT_TRACE_BUFFER_SIZE - 1)) != 0
+#error "EVENT_TRACE_BUFFER_SIZE must be a power of 2."
+#endif
+
+static struct TraceEvent sTraceEvents[EVENT_TRACE_BUFFER_SIZE];
+// Total number of events recorded, and how many of them have been sent over USB.
+static u32 sTraceHead = 0;
+static u32 sTraceSent = 0;
+// Calls and total time of the events recorded with event_trace_add_total since the last flush.
+static u32 sTraceTotalCalls[TRACE_EVENT_COUNT];
+static u32 sTraceTotalCycles[TRACE_EVENT_COUNT];
+
+static const char *sTraceEventNames[TRACE_EVENT_COUNT] = {
+    [TRACE_EVENT_FRAME        ] = "FRAME",
+    [TRACE_EVENT_OBJECT_UPDATE] = "OBJECT",
+    [TRACE_EVENT_FIND_FLOOR   ] = "FIND FLOOR",
+    [TRACE_EVENT_AUDIO_UPDATE ] = "AUDIO",
+    [TRACE_EVENT_GFX_TASK     ] = "GFX TASK",
+};
+
+/**
+ * Record an event. This can be called from any thread, since the audio thread can preempt the game thread.
+ */
+void event_trace_record(u8 id, u8 phase, u32 arg) {
+    u32 saved = __osDisableInt();
+    struct TraceEvent *event = &sTraceEvents[sTraceHead++ & (EVENT_TRACE_BUFFER_SIZE - 1)];
+
+    event->timestamp = osGetCount();
+    event->arg       = arg;
+    event->id        = id;
+    event->phase     = phase;
+    event->thread    = osGetThreadId(NULL);
+    __osRestoreInt(saved);
+}
+
+/**
+ * Add one call to an event's total for this frame. Only call this from the game thread.
+ */
+void event_trace_add_total(u8 id, u32 cycles) {
+    sTraceTotalCalls[id]++;
+    sTraceTotalCycles[id] += cycles;
+}
+
+/**
+ * Record a TRACE_PHASE_TOTAL event for every event with calls since the last frame.
+ */
+static void event_trace_record_totals(void) {
+    s32 id;
+
+    for (id = 0; id < TRACE_EVENT_COUNT; id++) {
+        if (sTraceTotalCalls[id] == 0) {
+            continue;
+        }
+
+        u32 calls = MIN(sTraceTotalCalls[id], 0xFFFF);
+        u32 usecs = MIN(OS_CYCLES_TO_USEC(sTraceTotalCycles[id]), 0xFFFF);
+
+        event_trace_record(id, TRACE_PHASE_TOTAL, ((calls << 16) | usecs));
+        sTraceTotalCalls[id] = 0;
+        sTraceTotalCycles[id] = 0;
+    }
+}
+
+const char *event_trace_get_name(u8 id) {
+    return (id < TRACE_EVENT_COUNT) ? sTraceEventNames[id] : "?";
+}
+
+/**
+ * Returns the event recorded index events ago (0 being the latest), or NULL if it has been overwritten.
+ */
+struct TraceEvent *event_trace_get_recent(s32 index) {
+    if ((u32) index >= MIN(sTraceHead, EVENT_TRACE_BUFFER_SIZE)) {
+        return NULL;
+    }
+
+    return &sTraceEvents[(sTraceHead - 1 - index) & (EVENT_TRACE_BUFFER_SIZE - 1)];
+}
+
+#ifdef UNF
+static u8 sTracePacket[sizeof(struct TracePacketHeader) + sizeof(sTraceEvents)] ALIGNED8;
+#endif
+
+/**
+ * Record this frame's totals, then send the events recorded since the last flush over USB. Called once per frame.
+ */
+void event_trace_flush(void) {
+    event_trace_record_totals();
+#ifdef UNF
+    struct TracePacketHeader *header = (struct TracePacketHeader *) sTracePacket;
+    struct TraceEvent *events = (struct TraceEvent *) (sTracePacket + sizeof(struct TracePacketHeader));
+    u32 head = sTraceHead;
+    u32 start = sTraceSent;
+    u32 count, first, firstCount;
+
+    header->dropped = 0;
+    if (head - start > EVENT_TRACE_BUFFER_SIZE) {
+        header->dropped = (head - start - EVENT_TRACE_BUFFER_SIZE);
+        start = (head - EVENT_TRACE_BUFFER_SIZE);
+    }
+
+    count = (head - start);
+    if (count == 0) {
+        return;
+    }
+
+    // Copy the events out of the ring buffer, in two parts if they wrap around.
+    first = (start & (EVENT_TRACE_BUFFER_SIZE - 1));
+    firstCount = MIN(count, EVENT_TRACE_BUFFER_SIZE - first);
+    memcpy(&events[0], &sTraceEvents[first], firstCount * sizeof(struct TraceEvent));
+    memcpy(&events[firstCount], &sTraceEvents[0], (count - firstCount) * sizeof(struct TraceEvent));
+    sTraceSent = head;
+
+    header->magic = TRACE_PACKET_MAGIC;
+    header->count = count;
+    usb_write(DATATYPE_RAWBINARY, sTracePacket, sizeof(struct TracePacketHeader) + (count * sizeof(struct TraceEvent)));
+#endif
+}
+
+#endif // EVENT_TRACER
@@ -0,0 +1,78 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * Binary event tracer.
+ *
+ * Events are stored in a ring buffer of EVENT_TRACE_BUFFER_SIZE entries, so the most recent
+ * events are always available, including from the crash screen.
+ *
+ * With UNF, every frame the events recorded since the last frame are sent with
+ * usb_write(DATATYPE_RAWBINARY) as a struct TracePacketHeader followed by `count` struct TraceEvents.
+ * All values are big endian. To convert a packet to Chrome trace events, each event becomes
+ * { "name": <id>, "ph": ("B" or "E"), "ts": timestamp / (OS_CPU_COUNTER / 1000000), "tid": thread }.
+ * Timestamps are osGetCount values, so they wrap around every ~91 seconds.
+ * tools/event_trace_to_chrome.py does this conversion.
+ *
+ * Functions that are called too often to record every call (like find_floor) are timed with
+ * TRACE_TIMER_START and TRACE_ADD_TOTAL instead, which only record one TRACE_PHASE_TOTAL event per frame.
+ */
+
+enum TraceEventIDs {
+    TRACE_EVENT_FRAME,         // One iteration of the game loop.
+    TRACE_EVENT_OBJECT_UPDATE, // arg: the object's behavior script.
+    TRACE_EVENT_FIND_FLOOR,
+    TRACE_EVENT_AUDIO_UPDATE,
+    TRACE_EVENT_GFX_TASK,      // Sending the frame's display list to the RSP.
+    TRACE_EVENT_COUNT
+};
+
+enum TraceEventPhases {
+    TRACE_PHASE_BEGIN,
+    TRACE_PHASE_END,
+    TRACE_PHASE_TOTAL, // arg: calls since the last frame << 16 | their total time in microseconds, both capped at 0xFFFF.
+};
+
+struct TraceEvent {
+    /*0x00*/ u32 timestamp;
+    /*0x04*/ u32 arg;
+    /*0x08*/ u8 id;
+    /*0x09*/ u8 phase;
+    /*0x0A*/ u8 thread;
+    /*0x0B*/ u8 filler;
+}; /*0x0C*/
+
+#define TRACE_PACKET_MAGIC 0x54524345 // "TRCE"
+
+struct TracePacketHeader {
+    /*0x00*/ u32 magic;
+    /*0x04*/ u32 count;   // number of events following the header
+    /*0x08*/ u32 dropped; // events overwritten in the ring buffer before they could be sent
+}; /*0x0C*/
+
+#ifdef EVENT_TRACER
+void event_trace_record(u8 id, u8 phase, u32 arg);
+void event_trace_add_total(u8 id, u32 cycles);
+void event_trace_flush(void);
+const char *event_trace_get_name(u8 id);
+struct TraceEvent *event_trace_get_recent(s32 index);
+
+#define TRACE_BEGIN(id, arg) event_trace_record((id), TRACE_PHASE_BEGIN, (u32)(arg))
+#define TRACE_END(id, arg)   event_trace_record((id), TRACE_PHASE_END,   (u32)(arg))
+#define TRACE_TIMER_START(start)   u32 start = osGetCount()
+#define TRACE_ADD_TOTAL(id, start) event_trace_add_total((id), (osGetCount() - (start)))
+#else
+#define event_trace_record(id, phase, arg)
+#define event_trace_add_total(id, cycles)
+#define event_trace_flush()
+#define TRACE_BEGIN(id, arg)
+#define TRACE_END(id, arg)
+#define TRACE_TIMER_START(start)
+#define TRACE_ADD_TOTAL(id, start)
+#endif
+
+#endif // EVENT_TRACE_H
@@ -32,6 +32,8 @@
 #include "profiling.h"
 #include "debug.h"
 #include "emutest.h"
+#include "event_trace.h"
+#include "behavior_profiler.h"
 
 // Emulators that the Instant Input patch should be applied to
 #define INSTANT_INPUT_WHITELIST (EMU_PARALLEL_LAUNCHER | EMU_PROJECT64 | EMU_MUPEN)
@@ -498,7 +500,9 @@ void display_and_vsync(void) {
         gGoddardVblankCallback();
         gGoddardVblankCallback = NULL;
     }
+    TRACE_BEGIN(TRACE_EVENT_GFX_TASK, 0);
     exec_display_list(&gGfxPool->spTask);
+    TRACE_END(TRACE_EVENT_GFX_TASK, 0);
 #ifndef UNLOCK_FPS
     osRecvMesg(&gGameVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
 #endif
@@ -800,6 +804,10 @@ void setup_game_memory(void) {
     load_segment(SEGMENT_LEVEL_ENTRY, _entrySegmentRomStart, _entrySegmentRomEnd, MEMORY_POOL_LEFT, NULL, NULL);
     // Setup Segment 2 (Fonts, Text, etc)
     load_segment_decompress(SEGMENT_SEGMENT2, _segment2_mio0SegmentRomStart, _segment2_mio0SegmentRomEnd);
+#ifdef ROM_RESIDENT_DIALOG
+    // Dialog text is read from ROM when it's needed
+    set_segment_rom_resident(SEGMENT_DIALOG_TEXT, _dialog_textSegmentRomStart);
+#endif
 }
 
 /**
@@ -841,6 +849,7 @@ void thread5_game_loop(UNUSED void *arg) {
             draw_reset_bars();
             continue;
         }
+        TRACE_BEGIN(TRACE_EVENT_FRAME, gGlobalTimer);
 #ifdef PUPPYPRINT_DEBUG
     bzero(&gPuppyCallCounter, sizeof(gPuppyCallCounter));
 #endif
@@ -860,6 +869,10 @@ void thread5_game_loop(UNUSED void *arg) {
         profiler_collision_reset();
         addr = level_script_execute(addr);
         profiler_collision_completed();
+#ifdef STREAM_LEVEL_SEGMENTS
+        stream_segments_update();
+#endif
+        behavior_profiler_update();
 #if !defined(PUPPYPRINT_DEBUG) && defined(VISUAL_DEBUG)
         debug_box_input();
 #endif
@@ -868,6 +881,8 @@ void thread5_game_loop(UNUSED void *arg) {
 #endif
 
         display_and_vsync();
+        TRACE_END(TRACE_EVENT_FRAME, gGlobalTimer - 1);
+        event_trace_flush();
 #ifdef VANILLA_DEBUG
         // when debug info is enabled, print the "BUF %d" information.
         if (gShowDebugText) {
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "puppycam2.h"
 #include "main.h"
+#include "text_batch.h"
 
 #ifdef VERSION_EU
 #undef LANGUAGE_FUNCTION
@@ -63,6 +64,61 @@ void *languageTable[][3] = {
 #endif
 };
 
+#ifdef ROM_RESIDENT_DIALOG
+static struct DialogEntry sRomDialogEntry;
+static u8 sRomDialogText[ROM_RESIDENT_DIALOG_BUFFER_SIZE];
+static s16 sRomDialogID = DIALOG_NONE;
+
+/**
+ * Read a dialog's entry and text from ROM, unless it's the one that was read last.
+ * The entry's str points to sRomDialogText instead of being a segmented address.
+ * Returns NULL if there's no dialog with that ID.
+ */
+static struct DialogEntry *read_rom_dialog_entry(s16 dialogID) {
+    const struct DialogEntry *entryAddr;
+    const u8 *textAddr;
+    u8 *text = sRomDialogText;
+    u8 *textEnd = &sRomDialogText[ROM_RESIDENT_DIALOG_BUFFER_SIZE - 1];
+
+    if (dialogID == sRomDialogID) {
+        return &sRomDialogEntry;
+    }
+    if ((u16) dialogID >= DIALOG_COUNT) {
+        return NULL;
+    }
+
+    rom_segment_read(&entryAddr, &seg2_dialog_table[dialogID], sizeof(entryAddr));
+    if (entryAddr == NULL) {
+        return NULL;
+    }
+    rom_segment_read(&sRomDialogEntry, entryAddr, sizeof(struct DialogEntry));
+
+    // The length of the text isn't stored, so read it in pieces until the terminator shows up.
+    textAddr = sRomDialogEntry.str;
+    while (text < textEnd) {
+        u32 size = MIN(64, (u32) (textEnd - text));
+        u32 i;
+
+        rom_segment_read(text, textAddr, size);
+        for (i = 0; i < size; i++) {
+            if (text[i] == DIALOG_CHAR_TERMINATOR) {
+                break;
+            }
+        }
+        if (i < size) {
+            break;
+        }
+        text += size;
+        textAddr += size;
+    }
+    *textEnd = DIALOG_CHAR_TERMINATOR;
+
+    sRomDialogEntry.str = sRomDialogText;
+    sRomDialogID = dialogID;
+    return &sRomDialogEntry;
+}
+#endif
+
 extern u8 gLastCompletedCourseNum;
 extern u8 gLastCompletedStarNum;
 
@@ -279,45 +335,58 @@ void render_generic_char(u8 c) {
 }
 #endif
 
-Texture32 *alloc_ia4_tex_from_i1(Texture *in, s16 width, s16 height) {
-    u32 size = (u32) width * (u32) height;
+#if MULTILANG
+/**
+ * Cache of the I1 font glyphs converted to IA4, so the conversion only happens once per
+ * glyph instead of every time it gets drawn. Entries are keyed by their source texture,
+ * so switching languages reconverts the glyphs that changed.
+ */
+static Texture sFontGlyphIA4Cache[256][8 * 8] ALIGNED8;
+static Texture *sFontGlyphIA4Sources[256];
+
+static Texture *get_ia4_font_glyph(u8 c, Texture *packedTexture) {
+    Texture *out = sFontGlyphIA4Cache[c];
     s32 inPos;
     s16 outPos = 0;
     u8 bitMask;
 
-    Texture *out = (Texture *) alloc_display_list(size);
-
-    if (out == NULL) {
-        return NULL;
-    }
-
-    for (inPos = 0; inPos < (width * height) / 4; inPos++) {
-        bitMask = 0x80;
+    if (sFontGlyphIA4Sources[c] != packedTexture) {
+        for (inPos = 0; inPos < (8 * 8) / 4; inPos++) {
+            bitMask = 0x80;
 
-        while (bitMask != 0) {
-            out[outPos] = (in[inPos] & bitMask) ? 0xF0 : 0x00;
-            bitMask /= 2;
-            out[outPos] = (in[inPos] & bitMask) ? out[outPos] + 0x0F : out[outPos];
-            bitMask /= 2;
-            outPos++;
+            while (bitMask != 0) {
+                out[outPos] = (packedTexture[inPos] & bitMask) ? 0xF0 : 0x00;
+                bitMask /= 2;
+                out[outPos] = (packedTexture[inPos] & bitMask) ? out[outPos] + 0x0F : out[outPos];
+                bitMask /= 2;
+                outPos++;
+            }
         }
+
+        osWritebackDCache(out, sizeof(sFontGlyphIA4Cache[c]));
+        sFontGlyphIA4Sources[c] = packedTexture;
     }
 
-    return (Texture32 *)out;
+    return out;
 }
+#endif
 
-void render_generic_char(u8 c) {
+/**
+ * Returns the texture used to draw a dialog font character.
+ */
+Texture *get_generic_char_texture(u8 c) {
     void **fontLUT = segmented_to_virtual(main_font_lut);
-    void *packedTexture = segmented_to_virtual(fontLUT[c]);
+    Texture *packedTexture = segmented_to_virtual(fontLUT[c]);
 #if MULTILANG
-    void *unpackedTexture = alloc_ia4_tex_from_i1(packedTexture, 8, 8);
-
-    gDPPipeSync(gDisplayListHead++);
-    gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_IA, G_IM_SIZ_16b, 1, VIRTUAL_TO_PHYSICAL(unpackedTexture));
+    return get_ia4_font_glyph(c, packedTexture);
 #else
-    gDPPipeSync(gDisplayListHead++);
-    gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_IA, G_IM_SIZ_16b, 1, VIRTUAL_TO_PHYSICAL(packedTexture));
+    return packedTexture;
 #endif
+}
+
+void render_generic_char(u8 c) {
+    gDPPipeSync(gDisplayListHead++);
+    gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_IA, G_IM_SIZ_16b, 1, VIRTUAL_TO_PHYSICAL(get_generic_char_texture(c)));
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_tex_settings);
 }
@@ -333,12 +402,22 @@ struct MultiTextEntry {
 
 enum MultiStringIDs { STRING_THE, STRING_YOU };
 
-/*
- * Place the multi-text string according to the ID passed. (US, EU)
+#define MAX_STRING_WIDTH 16
+
+/**
+ * Queue a dialog font character at the given offset from the string origin.
+ */
+static void add_generic_char(u8 c, s16 x, s16 y, u8 layer, u8 inherit, u32 color) {
+    text_batch_add(get_generic_char_texture(c), x, y, layer, inherit, color);
+}
+
+/**
+ * Queue the multi-text string according to the ID passed. (US, EU)
  * 0: 'the'
  * 1: 'you'
+ * Returns the x offset after the string.
  */
-void render_multi_text_string(s8 multiTextID) {
+static s16 add_multi_text_string(s8 multiTextID, s16 x, s16 y, u8 inherit, u32 color) {
     s8 i;
     struct MultiTextEntry textLengths[2] = {
         { 3, { TEXT_THE_RAW } },
@@ -346,30 +425,49 @@ void render_multi_text_string(s8 multiTextID) {
     };
 
     for (i = 0; i < textLengths[multiTextID].length; i++) {
-        render_generic_char(textLengths[multiTextID].str[i]);
-        create_dl_translation_matrix(MENU_MTX_NOPUSH, (f32)(gDialogCharWidths[textLengths[multiTextID].str[i]]), 0.0f, 0.0f);
+        add_generic_char(textLengths[multiTextID].str[i], x, y, TEXT_BATCH_LAYER_BASE, inherit, color);
+        x += gDialogCharWidths[textLengths[multiTextID].str[i]];
     }
+
+    return x;
 }
 
-#define MAX_STRING_WIDTH 16
-#define CHAR_WIDTH_SPACE (f32)(gDialogCharWidths[DIALOG_CHAR_SPACE])
-#define CHAR_WIDTH_DEFAULT (f32)(gDialogCharWidths[str[strPos]])
+/**
+ * The env color set with set_text_env_color, which print_generic_string draws uncolored text with.
+ */
+static u32 sTextEnvColor = TEXT_BATCH_COLOR(255, 255, 255, 255);
+
+/**
+ * Set the env color for text. Use this instead of gDPSetEnvColor before print_generic_string,
+ * so glyphs that inherit the color can still be drawn with it after a color code in the string.
+ */
+void set_text_env_color(u8 r, u8 g, u8 b, u8 a) {
+    gDPSetEnvColor(gDisplayListHead++, r, g, b, a);
+    sTextEnvColor = TEXT_BATCH_COLOR(r, g, b, a);
+}
 
 /**
  * Prints a generic white string.
  * In JP/EU a IA1 texture is used but in US a IA4 texture is used.
+ * Characters are positioned relative to a single matrix and drawn through the text batcher,
+ * so repeated characters share one texture load.
  */
 void print_generic_string(s16 x, s16 y, const u8 *str) {
     s8 mark = DIALOG_MARK_NONE; // unused in EU
     s32 strPos = 0;
     u8 lineNum = 1;
+    s16 charX = 0;
+    s16 charY = 0;
 
     s16 colorLoop;
     ColorRGBA rgbaColors = { 0x00, 0x00, 0x00, 0x00 };
+    u32 color = 0;
+    u8 inheritColor = TRUE;
     u8 customColor = 0;
     u8 diffTmp     = 0;
 
     create_dl_translation_matrix(MENU_MTX_PUSH, x, y, 0.0f);
+    text_batch_begin(TEXT_BATCH_IA_QUADS, sTextEnvColor);
 
     while (str[strPos] != DIALOG_CHAR_TERMINATOR) {
         switch (str[strPos]) {
@@ -402,12 +500,11 @@ void print_generic_string(s16 x, s16 y, const u8 *str) {
                 }
                 strPos--;
                 if (customColor == 1) {
-                    gDPSetEnvColor(gDisplayListHead++, rgbaColors[0],
-                                                    rgbaColors[1],
-                                                    rgbaColors[2],
-                                                    rgbaColors[3]);
+                    color = TEXT_BATCH_COLOR(rgbaColors[0], rgbaColors[1], rgbaColors[2], rgbaColors[3]);
+                    inheritColor = FALSE;
                 } else if (customColor == 2) {
-                    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255); // TODO: Is it possible to retrieve the original color that was set before print_generic_string was called?
+                    // Go back to the color that was set before print_generic_string was called.
+                    inheritColor = TRUE;
                     customColor = 0;
                 }
                 break;
@@ -418,44 +515,46 @@ void print_generic_string(s16 x, s16 y, const u8 *str) {
                 mark = DIALOG_MARK_HANDAKUTEN;
                 break;
             case DIALOG_CHAR_NEWLINE:
-                gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
-                create_dl_translation_matrix(MENU_MTX_PUSH, x, y - (lineNum * MAX_STRING_WIDTH), 0.0f);
+                charX = 0;
+                charY = -(lineNum * MAX_STRING_WIDTH);
                 lineNum++;
                 break;
             case DIALOG_CHAR_PERIOD:
-                create_dl_translation_matrix(MENU_MTX_PUSH, -2.0f, -5.0f, 0.0f);
-                render_generic_char(DIALOG_CHAR_PERIOD_OR_HANDAKUTEN);
-                gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
+                add_generic_char(DIALOG_CHAR_PERIOD_OR_HANDAKUTEN, charX - 2, charY - 5, TEXT_BATCH_LAYER_BASE, inheritColor, color);
                 break;
             case DIALOG_CHAR_SLASH:
-                create_dl_translation_matrix(MENU_MTX_NOPUSH, (f32)(gDialogCharWidths[DIALOG_CHAR_SPACE] * 2), 0.0f, 0.0f);
+                charX += gDialogCharWidths[DIALOG_CHAR_SPACE] * 2;
                 break;
             case DIALOG_CHAR_MULTI_THE:
-                render_multi_text_string(STRING_THE);
+                charX = add_multi_text_string(STRING_THE, charX, charY, inheritColor, color);
                 break;
             case DIALOG_CHAR_MULTI_YOU:
-                render_multi_text_string(STRING_YOU);
+                charX = add_multi_text_string(STRING_YOU, charX, charY, inheritColor, color);
                 break;
             case DIALOG_CHAR_SPACE:
-                // create_dl_translation_matrix(MENU_MTX_NOPUSH, (f32)(gDialogCharWidths[DIALOG_CHAR_SPACE]), 0.0f, 0.0f);
-                create_dl_translation_matrix(MENU_MTX_NOPUSH, CHAR_WIDTH_SPACE, 0.0f, 0.0f);
+                charX += gDialogCharWidths[DIALOG_CHAR_SPACE];
                 break;
             default:
-                render_generic_char(str[strPos]);
+                add_generic_char(str[strPos], charX, charY, TEXT_BATCH_LAYER_BASE, inheritColor, color);
                 if (mark != DIALOG_MARK_NONE) {
-                    create_dl_translation_matrix(MENU_MTX_PUSH, 5.0f, 5.0f, 0.0f);
-                    render_generic_char(DIALOG_CHAR_MARK_START + mark);
-                    gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
+                    add_generic_char(DIALOG_CHAR_MARK_START + mark, charX + 5, charY + 5, TEXT_BATCH_LAYER_OVERLAY, inheritColor, color);
                     mark = DIALOG_MARK_NONE;
                 }
 
-                create_dl_translation_matrix(MENU_MTX_NOPUSH, CHAR_WIDTH_DEFAULT, 0.0f, 0.0f);
+                charX += gDialogCharWidths[str[strPos]];
                 break;
         }
 
         strPos++;
     }
 
+    text_batch_end();
+
+    // Leave the env color as it would have been after drawing the string in order.
+    if (!inheritColor) {
+        set_text_env_color((color >> 24), ((color >> 16) & 0xFF), ((color >> 8) & 0xFF), (color & 0xFF));
+    }
+
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
 }
 
@@ -762,14 +861,14 @@ void render_dialog_box_type(struct DialogEntry *dialog, s8 linesPerBox) {
                 // convert the speed into angle
                 create_dl_rotation_matrix(MENU_MTX_NOPUSH, (gDialogBoxOpenTimer * 4.0f), 0, 0, 1.0f);
             }
-            gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 150);
+            set_text_env_color(0, 0, 0, 150);
             break;
         case DIALOG_TYPE_ZOOM: // Renders a dialog white box with zoom
             if (gDialogBoxState == DIALOG_STATE_OPENING || gDialogBoxState == DIALOG_STATE_CLOSING) {
                 create_dl_translation_matrix(MENU_MTX_NOPUSH, (65.0f - (65.0f / gDialogBoxScale)), ((40.0f / gDialogBoxScale) - 40), 0);
                 create_dl_scale_matrix(MENU_MTX_NOPUSH, (1.0f / gDialogBoxScale), (1.0f / gDialogBoxScale), 1.0f);
             }
-            gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 150);
+            set_text_env_color(255, 255, 255, 150);
             break;
     }
 
@@ -785,25 +884,25 @@ void change_and_flash_dialog_text_color_lines(s8 colorMode, s8 lineNum, u8 *cust
 
     if (colorMode == 1) {
         if (lineNum == 1) {
-            gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+            set_text_env_color(255, 255, 255, 255);
         } else {
             if (lineNum == gDialogLineNum) {
                 colorFade = (gSineTable[gDialogColorFadeTimer >> 4] * 50.0f) + 200.0f;
-                gDPSetEnvColor(gDisplayListHead++, colorFade, colorFade, colorFade, 255);
+                set_text_env_color(colorFade, colorFade, colorFade, 255);
             } else {
-                gDPSetEnvColor(gDisplayListHead++, 200, 200, 200, 255);
+                set_text_env_color(200, 200, 200, 255);
             }
         }
     } else {
         switch (gDialogBoxType) {
             case DIALOG_TYPE_ROTATE:
                 if (*customColor == 2) {
-                    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+                    set_text_env_color(255, 255, 255, 255);
                     *customColor = 0;
                 }
                 break;
             case DIALOG_TYPE_ZOOM:
-                gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 255);
+                set_text_env_color(0, 0, 0, 255);
                 break;
         }
     }
@@ -879,7 +978,11 @@ void handle_dialog_text_and_pages(s8 colorMode, struct DialogEntry *dialog, s8 l
     ColorRGBA rgbaColors = { 0x00, 0x00, 0x00, 0x00 };
     u8 customColor = 0;
     u8 diffTmp = 0;
+#ifdef ROM_RESIDENT_DIALOG
+    u8 *str = (u8 *) dialog->str;
+#else
     u8 *str = segmented_to_virtual(dialog->str);
+#endif
     s8 lineNum = 1;
     s8 totalLines;
     s8 pageState = DIALOG_PAGE_STATE_NONE;
@@ -908,7 +1011,7 @@ void handle_dialog_text_and_pages(s8 colorMode, struct DialogEntry *dialog, s8 l
 
     while (pageState == DIALOG_PAGE_STATE_NONE) {
         if (customColor == 1) {
-            gDPSetEnvColor(gDisplayListHead++, rgbaColors[0], rgbaColors[1], rgbaColors[2], rgbaColors[3]);
+            set_text_env_color(rgbaColors[0], rgbaColors[1], rgbaColors[2], rgbaColors[3]);
         } else {
             change_and_flash_dialog_text_color_lines(colorMode, lineNum, &customColor);
         }
@@ -1020,9 +1123,9 @@ void render_dialog_triangle_choice(void) {
     create_dl_translation_matrix(MENU_MTX_NOPUSH, (gDialogLineNum * X_VAL4_1) - X_VAL4_2, Y_VAL4_1 - (gLastDialogLineNum * Y_VAL4_2), 0);
 
     if (gDialogBoxType == DIALOG_TYPE_ROTATE) {
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+        set_text_env_color(255, 255, 255, 255);
     } else {
-        gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 255);
+        set_text_env_color(0, 0, 0, 255);
     }
 
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
@@ -1045,9 +1148,9 @@ void render_dialog_triangle_next(s8 linesPerBox) {
     create_dl_rotation_matrix(MENU_MTX_NOPUSH, -DEFAULT_DIALOG_BOX_ANGLE, 0, 0, 1.0f);
 
     if (gDialogBoxType == DIALOG_TYPE_ROTATE) { // White Text
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+        set_text_env_color(255, 255, 255, 255);
     } else { // Black Text
-        gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 255);
+        set_text_env_color(0, 0, 0, 255);
     }
 
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
@@ -1140,6 +1243,14 @@ s8  gDialogCourseActNum     =  1;
 
 void render_dialog_entries(void) {
     s8 lowerBound = 0;
+#ifdef ROM_RESIDENT_DIALOG
+    struct DialogEntry *dialog = read_rom_dialog_entry(gDialogID);
+
+    if (dialog == NULL) {
+        gDialogID = DIALOG_NONE;
+        return;
+    }
+#else
     void **dialogTable = segmented_to_virtual(languageTable[gInGameLanguage][0]);
     struct DialogEntry *dialog = segmented_to_virtual(dialogTable[gDialogID]);
 
@@ -1148,6 +1259,7 @@ void render_dialog_entries(void) {
         gDialogID = DIALOG_NONE;
         return;
     }
+#endif
 
     switch (gDialogBoxState) {
         case DIALOG_STATE_OPENING:
@@ -1259,7 +1371,7 @@ void reset_cutscene_msg_fade(void) {
 
 void dl_rgba16_begin_cutscene_msg_fade(void) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gCutsceneMsgFade);
+    set_text_env_color(255, 255, 255, gCutsceneMsgFade);
 }
 
 void dl_rgba16_stop_cutscene_msg_fade(void) {
@@ -1320,7 +1432,7 @@ void do_cutscene_handler(void) {
     create_dl_ortho_matrix();
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gCutsceneMsgFade);
+    set_text_env_color(255, 255, 255, gCutsceneMsgFade);
 
     // get the x coordinate of where the cutscene string starts.
     s16 x = get_str_x_pos_from_center(gCutsceneMsgXOffset, gEndCutsceneStringsEn[gCutsceneMsgIndex], 10.0f);
@@ -1363,6 +1475,10 @@ void do_cutscene_handler(void) {
 
 // "Dear Mario" message handler
 void print_peach_letter_message(void) {
+#ifdef ROM_RESIDENT_DIALOG
+    struct DialogEntry *dialog = read_rom_dialog_entry(gDialogID);
+    u8 *str = (u8 *) dialog->str;
+#else
 #ifdef VERSION_EU
     void **dialogTable;
     gInGameLanguage = eu_get_language();
@@ -1377,23 +1493,24 @@ void print_peach_letter_message(void) {
 #endif
     struct DialogEntry *dialog = segmented_to_virtual(dialogTable[gDialogID]);
     u8 *str = segmented_to_virtual(dialog->str);
+#endif
 
     create_dl_translation_matrix(MENU_MTX_PUSH, 97.0f, 118.0f, 0);
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gCutsceneMsgFade);
+    set_text_env_color(255, 255, 255, gCutsceneMsgFade);
     gSPDisplayList(gDisplayListHead++, castle_grounds_seg7_dl_0700EA58);
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 20, 20, 20, gCutsceneMsgFade);
+    set_text_env_color(20, 20, 20, gCutsceneMsgFade);
 
     print_generic_string(STR_X, STR_Y, str);
 #ifdef VERSION_JP
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+    set_text_env_color(255, 255, 255, 255);
 #else
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+    set_text_env_color(255, 255, 255, 255);
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
-    gDPSetEnvColor(gDisplayListHead++, 200, 80, 120, gCutsceneMsgFade);
+    set_text_env_color(200, 80, 120, gCutsceneMsgFade);
     gSPDisplayList(gDisplayListHead++, castle_grounds_seg7_us_dl_0700F2E8);
 #endif
 
@@ -1432,7 +1549,7 @@ void print_peach_letter_message(void) {
 void render_hud_cannon_reticle(void) {
     create_dl_translation_matrix(MENU_MTX_PUSH, 160.0f, 120.0f, 0);
 
-    gDPSetEnvColor(gDisplayListHead++, 50, 50, 50, 180);
+    set_text_env_color(50, 50, 50, 180);
     create_dl_translation_matrix(MENU_MTX_PUSH, -20.0f, -8.0f, 0);
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
@@ -1550,7 +1667,7 @@ void render_pause_red_coins(void) {
 #if defined(WIDE) && !defined(PUPPYCAM)
 void render_widescreen_setting(void) {
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     if (!gConfig.widescreen) {
         print_generic_string(10, 20, textCurrRatio43);
         print_generic_string(10,  7, textPressL);
@@ -1605,7 +1722,7 @@ void render_pause_my_score_coins(void) {
     u8 starFlags = save_file_get_star_flags(gCurrSaveFileNum - 1, COURSE_NUM_TO_INDEX(gCurrCourseNum));
 
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     if (courseIndex <= COURSE_NUM_TO_INDEX(COURSE_STAGES_MAX)) {
         print_hud_my_score_coins(1, gCurrSaveFileNum - 1, courseIndex, 178, 103);
@@ -1615,7 +1732,7 @@ void render_pause_my_score_coins(void) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     if (courseIndex <= COURSE_NUM_TO_INDEX(COURSE_STAGES_MAX)
         && (save_file_get_course_star_count(gCurrSaveFileNum - 1, courseIndex) != 0)) {
@@ -1659,7 +1776,7 @@ void render_pause_camera_options(s16 x, s16 y, s8 *index, s16 xIndex) {
     handle_menu_scrolling(MENU_SCROLL_HORIZONTAL, index, 1, 2);
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     print_generic_string(x +     14, y +  2, textLakituMario);
     print_generic_string(x + TXT1_X, y - 13, LANGUAGE_ARRAY(textNormalUpClose));
@@ -1668,7 +1785,7 @@ void render_pause_camera_options(s16 x, s16 y, s8 *index, s16 xIndex) {
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
     create_dl_translation_matrix(MENU_MTX_PUSH, ((*index - 1) * xIndex) + x, y + Y_VAL7, 0);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
 
@@ -1693,7 +1810,7 @@ void render_pause_course_options(s16 x, s16 y, s8 *index, s16 yIndex) {
     handle_menu_scrolling(MENU_SCROLL_VERTICAL, index, 1, 3);
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     print_generic_string(x + 10, y - 2, LANGUAGE_ARRAY(textContinue));
     print_generic_string(x + 10, y - 17, LANGUAGE_ARRAY(textExitCourse));
@@ -1704,7 +1821,7 @@ void render_pause_course_options(s16 x, s16 y, s8 *index, s16 yIndex) {
 
         create_dl_translation_matrix(MENU_MTX_PUSH, x - X_VAL8, (y - ((*index - 1) * yIndex)) - Y_VAL8, 0);
 
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+        set_text_env_color(255, 255, 255, gDialogTextAlpha);
         gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
         gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
     }
@@ -1717,14 +1834,14 @@ void render_pause_course_options(s16 x, s16 y, s8 *index, s16 yIndex) {
 void render_pause_castle_menu_box(s16 x, s16 y) {
     create_dl_translation_matrix(MENU_MTX_PUSH, x - 78, y - 32, 0);
     create_dl_scale_matrix(MENU_MTX_NOPUSH, 1.2f, 0.8f, 1.0f);
-    gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 105);
+    set_text_env_color(0, 0, 0, 105);
     gSPDisplayList(gDisplayListHead++, dl_draw_text_bg_box);
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
 
     create_dl_translation_matrix(MENU_MTX_PUSH, x + 6, y - 28, 0);
     create_dl_rotation_matrix(MENU_MTX_NOPUSH, DEFAULT_DIALOG_BOX_ANGLE, 0, 0, 1.0f);
     gDPPipeSync(gDisplayListHead++);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
 
@@ -1754,7 +1871,7 @@ void print_hud_pause_colorful_str(void) {
     u8 textPause[] = { TEXT_PAUSE };
 
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     print_hud_lut_string(HUD_LUT_GLOBAL, 123, 81, textPause);
 
@@ -1842,7 +1959,7 @@ void render_pause_castle_main_strings(s16 x, s16 y) {
     }
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     if (gDialogLineNum <= COURSE_NUM_TO_INDEX(COURSE_STAGES_MAX)) { // Main courses
         courseName = segmented_to_virtual(courseNameTbl[gDialogLineNum]);
@@ -1976,7 +2093,7 @@ void print_hud_course_complete_string(s8 str) {
     u8 colorFade = sins(gDialogColorFadeTimer) * 50.0f + 200.0f;
 
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, colorFade, colorFade, colorFade, 255);
+    set_text_env_color(colorFade, colorFade, colorFade, 255);
 
     if (str == HUD_PRINT_HISCORE) {
         print_hud_lut_string(HUD_LUT_GLOBAL, TXT_HISCORE_X,  TXT_HISCORE_Y,  LANGUAGE_ARRAY(textHiScore));
@@ -1993,7 +2110,7 @@ void print_hud_course_complete_coins(s16 x, s16 y) {
     u8 hudTextSymX[] = { GLYPH_MULTIPLY, GLYPH_SPACE };
 
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+    set_text_env_color(255, 255, 255, 255);
 
     print_hud_lut_string(HUD_LUT_GLOBAL, x +  0, y, hudTextSymCoin);
     print_hud_lut_string(HUD_LUT_GLOBAL, x + 16, y, hudTextSymX);
@@ -2061,10 +2178,10 @@ void render_course_complete_lvl_info_and_hud_str(void) {
         // Print course name and clear text
         gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
 
-        gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, gDialogTextAlpha);
+        set_text_env_color(0, 0, 0, gDialogTextAlpha);
         print_generic_string(TXT_NAME_X1, 130, name);
         print_generic_string(TXT_CLEAR_X1, 130, textClear);
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+        set_text_env_color(255, 255, 255, gDialogTextAlpha);
         print_generic_string(TXT_NAME_X2, 132, name);
         print_generic_string(TXT_CLEAR_X2, 132, textClear);
         gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
@@ -2088,11 +2205,11 @@ void render_course_complete_lvl_info_and_hud_str(void) {
 
         int_to_str(gLastCompletedCourseNum, strCourseNum);
 
-        gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, gDialogTextAlpha);
+        set_text_env_color(0, 0, 0, gDialogTextAlpha);
         print_generic_string(65, 165, LANGUAGE_ARRAY(textCourse));
         print_generic_string(CRS_NUM_X2, 165, strCourseNum);
 
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+        set_text_env_color(255, 255, 255, gDialogTextAlpha);
         print_generic_string(63, 167, LANGUAGE_ARRAY(textCourse));
         print_generic_string(CRS_NUM_X3, 167, strCourseNum);
 
@@ -2107,7 +2224,7 @@ void render_course_complete_lvl_info_and_hud_str(void) {
     // Print star glyph
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     print_hud_lut_string(HUD_LUT_GLOBAL, 55, 77, textSymStar);
 
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
@@ -2115,10 +2232,10 @@ void render_course_complete_lvl_info_and_hud_str(void) {
     // Print act name and catch text
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
 
-    gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, gDialogTextAlpha);
+    set_text_env_color(0, 0, 0, gDialogTextAlpha);
     print_generic_string(76, 145, name);
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     print_generic_string(74, 147, name);
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
@@ -2138,7 +2255,7 @@ void render_save_confirmation(s16 x, s16 y, s8 *index, s16 yPos) {
     handle_menu_scrolling(MENU_SCROLL_VERTICAL, index, 1, 3);
 
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
 
     print_generic_string(TXT_SAVEOPTIONS_X, y + TXT_SAVECONT_Y, LANGUAGE_ARRAY(textSaveAndContinue));
     print_generic_string(TXT_SAVEOPTIONS_X, y - TXT_SAVEQUIT_Y, LANGUAGE_ARRAY(textSaveAndQuit));
@@ -2148,7 +2265,7 @@ void render_save_confirmation(s16 x, s16 y, s8 *index, s16 yPos) {
 
     create_dl_translation_matrix(MENU_MTX_PUSH, X_VAL9, y - ((*index - 1) * yPos), 0);
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, gDialogTextAlpha);
+    set_text_env_color(255, 255, 255, gDialogTextAlpha);
     gSPDisplayList(gDisplayListHead++, dl_draw_triangle);
 
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
@@ -0,0 +1,349 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "area.h"
+#include "camera.h"
+#include "lazy_spawn.h"
+#include "level_update.h"
+#include "macro_special_objects.h"
+#include "object_list_processor.h"
+#include "platform_displacement.h"
+#include "spawn_object.h"
+#include "engine/math_util.h"
+#include "engine/surface_collision.h"
+
+#ifdef LAZY_OBJECT_SPAWNING
+
+/**
+ * Lazy area object spawning.
+ *
+ * Instead of instantiating every object of an area on load, objects from the lists accepted by
+ * lazy_spawn_is_streamable_list are recorded in a spawn index which is sorted by collision cell.
+ * Every frame, the cells around Mario and the camera are walked and any indexed object within
+ * LAZY_SPAWN_RADIUS is spawned. Spawned objects that end up further than LAZY_DESPAWN_RADIUS from
+ * both are unloaded again, and will respawn from their original spawn data once back in range.
+ *
+ * Objects that unload themselves (killed, collected, etc.) are marked as consumed and won't come back
+ * until the area is reloaded, matching vanilla. The respawn info bits are still honored, so objects
+ * flagged with RESPAWN_INFO_DONT_RESPAWN are never put back into the world either.
+ */
+
+#define LAZY_SPAWN_CELL_KEY(cellX, cellZ) (((cellZ) * NUM_CELLS) + (cellX))
+
+/**
+ * How many spawned index entries get checked for despawning each frame.
+ */
+#define LAZY_SPAWN_CHECKS_PER_FRAME 16
+
+enum LazySpawnFlags {
+    LAZY_SPAWN_FLAG_NONE     = (0 << 0),
+    LAZY_SPAWN_FLAG_CONSUMED = (1 << 0), // The object unloaded itself, don't spawn it again until the area reloads.
+};
+
+struct LazySpawnEntry {
+    /*0x00*/ void *source;
+    /*0x04*/ struct Object *obj;
+    /*0x08*/ s16 posX;
+    /*0x0A*/ s16 posZ;
+    /*0x0C*/ u16 cellKey;
+    /*0x0E*/ u8 type;
+    /*0x0F*/ u8 flags;
+}; /*0x10*/
+
+static struct LazySpawnEntry sLazySpawnIndex[LAZY_SPAWN_INDEX_SIZE];
+static s32 sLazySpawnCount = 0;
+static s32 sLazySpawnNextCheck = 0;
+static u8 sLazySpawnNeedsSort = FALSE;
+static u32 sLazySpawnParentBits[(OBJECT_POOL_CAPACITY + 31) / 32]; // Pool slots that have an active child.
+
+/**
+ * Only objects in these lists get streamed. Level objects (warps, coins, stars), spawners, surface
+ * objects and polelike objects are either searched for by other objects or can have Mario attached
+ * to them, so they are always spawned on area load.
+ */
+static s32 lazy_spawn_is_streamable_list(s32 objList) {
+    switch (objList) {
+        case OBJ_LIST_GENACTOR:
+        case OBJ_LIST_PUSHABLE:
+        case OBJ_LIST_DEFAULT:
+        case OBJ_LIST_UNIMPORTANT:
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ * Clear the spawn index. Called when an area starts loading.
+ */
+void lazy_spawn_reset(void) {
+    sLazySpawnCount = 0;
+    sLazySpawnNextCheck = 0;
+    sLazySpawnNeedsSort = FALSE;
+}
+
+/**
+ * Try to add an object to the spawn index instead of spawning it right away.
+ * Returns TRUE if the object was deferred, in which case the caller must not spawn it.
+ */
+s32 lazy_spawn_defer(u8 type, void *source, const BehaviorScript *behavior, s16 x, s16 z) {
+    s32 objList = OBJ_LIST_DEFAULT;
+
+    if (behavior == NULL || sLazySpawnCount >= LAZY_SPAWN_INDEX_SIZE) {
+        return FALSE;
+    }
+
+    // Same object list extraction as create_object.
+    behavior = segmented_to_virtual(behavior);
+    if ((behavior[0] >> 24) == 0) {
+        objList = (behavior[0] >> 16) & 0xFFFF;
+    }
+
+    if (!lazy_spawn_is_streamable_list(objList)) {
+        return FALSE;
+    }
+
+    struct LazySpawnEntry *entry = &sLazySpawnIndex[sLazySpawnCount++];
+
+    entry->source  = source;
+    entry->obj     = NULL;
+    entry->posX    = x;
+    entry->posZ    = z;
+    entry->cellKey = LAZY_SPAWN_CELL_KEY(GET_CELL_COORD(x), GET_CELL_COORD(z));
+    entry->type    = type;
+    entry->flags   = LAZY_SPAWN_FLAG_NONE;
+
+    sLazySpawnNeedsSort = TRUE;
+
+    return TRUE;
+}
+
+/**
+ * Sort the index by cell so each row of cells is a contiguous range. Insertion sort, since this
+ * only runs once per area load and the input is usually already grouped by location.
+ */
+static void lazy_spawn_sort(void) {
+    s32 i, j;
+    struct LazySpawnEntry temp;
+
+    for (i = 1; i < sLazySpawnCount; i++) {
+        temp = sLazySpawnIndex[i];
+        for (j = i - 1; j >= 0 && sLazySpawnIndex[j].cellKey > temp.cellKey; j--) {
+            sLazySpawnIndex[j + 1] = sLazySpawnIndex[j];
+        }
+        sLazySpawnIndex[j + 1] = temp;
+    }
+
+    sLazySpawnNeedsSort = FALSE;
+}
+
+/**
+ * Returns the index of the first entry whose cell key is >= key.
+ */
+static s32 lazy_spawn_lower_bound(u16 key) {
+    s32 low = 0;
+    s32 high = sLazySpawnCount;
+
+    while (low < high) {
+        s32 mid = (low + high) >> 1;
+        if (sLazySpawnIndex[mid].cellKey < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * Returns a pointer to the respawn info of an entry's spawn data, the same pointer
+ * the spawned object stores in obj->respawnInfo.
+ */
+static void *lazy_spawn_get_respawn_info(struct LazySpawnEntry *entry) {
+    if (entry->type == LAZY_SPAWN_TYPE_SPAWN_INFO) {
+        return &((struct SpawnInfo *) entry->source)->behaviorArg;
+    } else {
+        return (MacroObject *) entry->source + 4;
+    }
+}
+
+static s32 lazy_spawn_is_dont_respawn(struct LazySpawnEntry *entry) {
+    if (entry->type == LAZY_SPAWN_TYPE_SPAWN_INFO) {
+        u32 behaviorArg = ((struct SpawnInfo *) entry->source)->behaviorArg;
+        return ((behaviorArg & (RESPAWN_INFO_DONT_RESPAWN << 8)) == (RESPAWN_INFO_DONT_RESPAWN << 8));
+    } else {
+        s16 params = *((MacroObject *) entry->source + 4);
+        return ((GET_BPARAM3(params) & RESPAWN_INFO_DONT_RESPAWN) == RESPAWN_INFO_DONT_RESPAWN);
+    }
+}
+
+/**
+ * Whether the object an entry spawned is still the one occupying its object slot.
+ */
+static s32 lazy_spawn_obj_is_alive(struct LazySpawnEntry *entry) {
+    struct Object *obj = entry->obj;
+
+    return ((obj->activeFlags & ACTIVE_FLAG_ACTIVE)
+            && obj->respawnInfo == lazy_spawn_get_respawn_info(entry));
+}
+
+/**
+ * Walk the object pool once and mark every slot that is the parent of another active object.
+ */
+static void lazy_spawn_mark_parents(void) {
+    s32 i;
+
+    bzero(sLazySpawnParentBits, sizeof(sLazySpawnParentBits));
+
+    for (i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+        struct Object *child = &gObjectPool[i];
+        s32 parentSlot = (child->parentObj - gObjectPool);
+
+        if ((child->activeFlags & ACTIVE_FLAG_ACTIVE) && child->parentObj != child
+            && parentSlot >= 0 && parentSlot < OBJECT_POOL_CAPACITY) {
+            sLazySpawnParentBits[parentSlot >> 5] |= (1 << (parentSlot & 0x1F));
+        }
+    }
+}
+
+/**
+ * Objects that Mario, the camera or another object currently depend on can't be unloaded.
+ * Requires the parents to have been marked with lazy_spawn_mark_parents.
+ */
+static s32 lazy_spawn_can_despawn(struct Object *obj) {
+    s32 slot = (obj - gObjectPool);
+
+    if (obj == gMarioState->heldObj || obj == gMarioState->riddenObj || obj == gMarioState->usedObj
+        || obj == gMarioState->interactObj || obj == gMarioPlatform
+        || obj == gCutsceneFocus || obj == gSecondCameraFocus
+        || obj->oHeldState != HELD_FREE) {
+        return FALSE;
+    }
+
+    return !(sLazySpawnParentBits[slot >> 5] & (1 << (slot & 0x1F)));
+}
+
+static void lazy_spawn_entry(struct LazySpawnEntry *entry) {
+    if (entry->type == LAZY_SPAWN_TYPE_SPAWN_INFO) {
+        entry->obj = spawn_object_from_spawn_info(entry->source);
+    } else {
+        gMacroObjectDefaultParent.header.gfx.areaIndex = gCurrAreaIndex;
+        gMacroObjectDefaultParent.header.gfx.activeAreaIndex = gCurrAreaIndex;
+        entry->obj = spawn_macro_object(entry->source);
+    }
+}
+
+/**
+ * Spawn every idle entry within LAZY_SPAWN_RADIUS of pos.
+ */
+static void lazy_spawn_objects_near(Vec3f pos) {
+    s32 minCellX = GET_CELL_COORD(CLAMP(pos[0] - LAZY_SPAWN_RADIUS, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1));
+    s32 maxCellX = GET_CELL_COORD(CLAMP(pos[0] + LAZY_SPAWN_RADIUS, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1));
+    s32 minCellZ = GET_CELL_COORD(CLAMP(pos[2] - LAZY_SPAWN_RADIUS, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1));
+    s32 maxCellZ = GET_CELL_COORD(CLAMP(pos[2] + LAZY_SPAWN_RADIUS, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1));
+    s32 cellZ, i;
+
+    for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        u16 lastKey = LAZY_SPAWN_CELL_KEY(maxCellX, cellZ);
+
+        for (i = lazy_spawn_lower_bound(LAZY_SPAWN_CELL_KEY(minCellX, cellZ));
+             i < sLazySpawnCount && sLazySpawnIndex[i].cellKey <= lastKey; i++) {
+            struct LazySpawnEntry *entry = &sLazySpawnIndex[i];
+
+            if (entry->obj != NULL || (entry->flags & LAZY_SPAWN_FLAG_CONSUMED)) {
+                continue;
+            }
+
+            f32 dx = entry->posX - pos[0];
+            f32 dz = entry->posZ - pos[2];
+            if ((sqr(dx) + sqr(dz)) > sqr(LAZY_SPAWN_RADIUS)) {
+                continue;
+            }
+
+            if (lazy_spawn_is_dont_respawn(entry)) {
+                entry->flags |= LAZY_SPAWN_FLAG_CONSUMED;
+                continue;
+            }
+
+            // Leave the remaining slots to objects spawned by behaviors, try again next frame.
+            if (gFreeObjectList.next == NULL) {
+                return;
+            }
+
+            lazy_spawn_entry(entry);
+        }
+    }
+}
+
+static f32 lazy_spawn_lateral_dist_sq(struct Object *obj, Vec3f pos) {
+    f32 dx = obj->oPosX - pos[0];
+    f32 dz = obj->oPosZ - pos[2];
+    return (sqr(dx) + sqr(dz));
+}
+
+/**
+ * Check a few spawned entries per frame, unloading the ones that are now out of range.
+ */
+static void lazy_despawn_far_objects(Vec3f marioPos, Vec3f camPos) {
+    s32 checks = MIN(LAZY_SPAWN_CHECKS_PER_FRAME, sLazySpawnCount);
+    s32 parentsMarked = FALSE;
+
+    while (checks-- > 0) {
+        struct LazySpawnEntry *entry = &sLazySpawnIndex[sLazySpawnNextCheck];
+
+        if (++sLazySpawnNextCheck >= sLazySpawnCount) {
+            sLazySpawnNextCheck = 0;
+        }
+
+        if (entry->obj == NULL) {
+            continue;
+        }
+
+        // The object unloaded itself and its slot may have been reused since.
+        if (!lazy_spawn_obj_is_alive(entry)) {
+            entry->obj = NULL;
+            entry->flags |= LAZY_SPAWN_FLAG_CONSUMED;
+            continue;
+        }
+
+        struct Object *obj = entry->obj;
+        if (lazy_spawn_lateral_dist_sq(obj, marioPos) <= sqr(LAZY_DESPAWN_RADIUS)
+            || lazy_spawn_lateral_dist_sq(obj, camPos) <= sqr(LAZY_DESPAWN_RADIUS)) {
+            continue;
+        }
+
+        // Only walk the object pool on frames where something is actually out of range.
+        if (!parentsMarked) {
+            lazy_spawn_mark_parents();
+            parentsMarked = TRUE;
+        }
+
+        if (lazy_spawn_can_despawn(obj)) {
+            unload_object(obj);
+            entry->obj = NULL;
+        }
+    }
+}
+
+/**
+ * Spawn and despawn indexed objects around Mario and the camera. Called once per frame before
+ * objects are updated, so newly spawned objects run their first update on the same frame.
+ */
+void lazy_spawn_update(void) {
+    if (sLazySpawnCount == 0 || gMarioObject == NULL || (gTimeStopState & TIME_STOP_ACTIVE)) {
+        return;
+    }
+
+    if (sLazySpawnNeedsSort) {
+        lazy_spawn_sort();
+    }
+
+    gObjectLists = gObjectListArray;
+
+    lazy_despawn_far_objects(gMarioState->pos, gLakituState.curPos);
+    lazy_spawn_objects_near(gMarioState->pos);
+    lazy_spawn_objects_near(gLakituState.curPos);
+}
+
+#endif // LAZY_OBJECT_SPAWNING
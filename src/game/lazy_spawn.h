@@ -0,0 +1,26 @@
+#ifndef LAZY_SPAWN_H
+#define LAZY_SPAWN_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * Where a deferred object's spawn data lives, so it can be spawned (again) later.
+ */
+enum LazySpawnTypes {
+    LAZY_SPAWN_TYPE_SPAWN_INFO,   // source is a struct SpawnInfo
+    LAZY_SPAWN_TYPE_MACRO_OBJECT, // source is the first MacroObject of a macro object entry
+};
+
+#ifdef LAZY_OBJECT_SPAWNING
+void lazy_spawn_reset(void);
+s32 lazy_spawn_defer(u8 type, void *source, const BehaviorScript *behavior, s16 x, s16 z);
+void lazy_spawn_update(void);
+#else
+#define lazy_spawn_reset()
+#define lazy_spawn_defer(type, source, behavior, x, z) FALSE
+#define lazy_spawn_update()
+#endif
+
+#endif // LAZY_SPAWN_H
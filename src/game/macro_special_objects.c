@@ -2,6 +2,7 @@
 
 #include "sm64.h"
 #include "object_helpers.h"
+#include "lazy_spawn.h"
 #include "macro_special_objects.h"
 #include "object_list_processor.h"
 
@@ -83,12 +84,65 @@ struct LoadedMacroObject {
     /*0x08*/ s16 params;
 };
 
-void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList) {
-    s32 presetID;
+/*
+ * Spawns a single macro object from its entry in a macro object list.
+ * Returns NULL if the object has been killed/collected before.
+ */
+struct Object *spawn_macro_object(MacroObject *macroObj) {
+    s32 presetID = (*macroObj & 0x1FF) - 31; // Preset identifier for MacroObjectPresets array
     struct LoadedMacroObject macroObject;
     struct Object *newObj;
     struct MacroPreset preset;
 
+    // Set macro object properties from the list
+    macroObject.yaw    = ((*macroObj++ >> 9) & 0x7F) << 1; // Y-Rotation
+    macroObject.pos[0] = *macroObj++;                      // X position
+    macroObject.pos[1] = *macroObj++;                      // Y position
+    macroObject.pos[2] = *macroObj++;                      // Z position
+    macroObject.params = *macroObj;                        // Behavior params
+
+    // Get the preset values from the MacroObjectPresets list.
+    preset = MacroObjectPresets[presetID];
+
+    // If the preset has a defined param, replace the lower bits with the preset param.
+    // The lower bits are later used for bparam2.
+    if (preset.param != 0) {
+        macroObject.params = (macroObject.params & 0xFF00) + (preset.param & 0x00FF);
+    }
+
+    // If object has been killed (bparam3 check), prevent it from respawning
+    if ((GET_BPARAM3(macroObject.params) & RESPAWN_INFO_DONT_RESPAWN) == RESPAWN_INFO_DONT_RESPAWN) {
+        return NULL;
+    }
+
+    // Spawn the new macro object.
+    newObj = spawn_object_abs_with_rot(
+                 &gMacroObjectDefaultParent,        // Parent object
+                 0,                                 // Unused
+                 preset.model,                      // Model ID
+                 preset.behavior,                   // Behavior address
+                 macroObject.pos[0],                // X-position
+                 macroObject.pos[1],                // Y-position
+                 macroObject.pos[2],                // Z-position
+                 0x0,                               // X-rotation
+                 convert_rotation(macroObject.yaw), // Y-rotation
+                 0x0                                // Z-rotation
+             );
+
+    newObj->oUnusedCoinParams =    macroObject.params;
+    newObj->oBehParams        = (((macroObject.params & 0x00FF) << 16) // Set 2nd byte from lower bits (shifted).
+                                | (macroObject.params & 0xFF00));      // Set 3rd byte from upper bits.
+    newObj->oBehParams2ndByte =   (macroObject.params & 0x00FF);       // Set 2nd byte from lower bits.
+    newObj->respawnInfoType = RESPAWN_INFO_TYPE_MACRO_OBJECT;
+    newObj->respawnInfo = macroObj;
+    newObj->parentObj = newObj;
+
+    return newObj;
+}
+
+void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList) {
+    s32 presetID;
+
     gMacroObjectDefaultParent.header.gfx.areaIndex = areaIndex;
     gMacroObjectDefaultParent.header.gfx.activeAreaIndex = areaIndex;
 
@@ -103,46 +157,14 @@ void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList) {
             break;
         }
 
-        // Set macro object properties from the list
-        macroObject.yaw    = ((*macroObjList++ >> 9) & 0x7F) << 1; // Y-Rotation
-        macroObject.pos[0] = *macroObjList++;                      // X position
-        macroObject.pos[1] = *macroObjList++;                      // Y position
-        macroObject.pos[2] = *macroObjList++;                      // Z position
-        macroObject.params = *macroObjList++;                      // Behavior params
-
-        // Get the preset values from the MacroObjectPresets list.
-        preset = MacroObjectPresets[presetID];
-
-        // If the preset has a defined param, replace the lower bits with the preset param.
-        // The lower bits are later used for bparam2.
-        if (preset.param != 0) {
-            macroObject.params = (macroObject.params & 0xFF00) + (preset.param & 0x00FF);
+        // With lazy spawning, objects in streamable lists are added to the spawn index instead,
+        // and get spawned once Mario or the camera come within range.
+        if (!lazy_spawn_defer(LAZY_SPAWN_TYPE_MACRO_OBJECT, macroObjList, MacroObjectPresets[presetID].behavior,
+                              macroObjList[1], macroObjList[3])) {
+            spawn_macro_object(macroObjList);
         }
 
-        // If object has been killed (bparam3 check), prevent it from respawning
-        if ((GET_BPARAM3(macroObject.params) & RESPAWN_INFO_DONT_RESPAWN) != RESPAWN_INFO_DONT_RESPAWN) {
-            // Spawn the new macro object.
-            newObj = spawn_object_abs_with_rot(
-                         &gMacroObjectDefaultParent,        // Parent object
-                         0,                                 // Unused
-                         preset.model,                      // Model ID
-                         preset.behavior,                   // Behavior address
-                         macroObject.pos[0],                // X-position
-                         macroObject.pos[1],                // Y-position
-                         macroObject.pos[2],                // Z-position
-                         0x0,                               // X-rotation
-                         convert_rotation(macroObject.yaw), // Y-rotation
-                         0x0                                // Z-rotation
-                     );
-
-            newObj->oUnusedCoinParams =    macroObject.params;
-            newObj->oBehParams        = (((macroObject.params & 0x00FF) << 16) // Set 2nd byte from lower bits (shifted).
-                                        | (macroObject.params & 0xFF00));      // Set 3rd byte from upper bits.
-            newObj->oBehParams2ndByte =   (macroObject.params & 0x00FF);       // Set 2nd byte from lower bits.
-            newObj->respawnInfoType = RESPAWN_INFO_TYPE_MACRO_OBJECT;
-            newObj->respawnInfo = macroObjList - 1;
-            newObj->parentObj = newObj;
-        }
+        macroObjList += 5;
     }
 }
 
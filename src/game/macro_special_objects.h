@@ -11,6 +11,7 @@ void spawn_macro_abs_yrot_2params(ModelID32 model, const BehaviorScript *behavio
 void spawn_macro_abs_yrot_param1(ModelID32 model, const BehaviorScript *behavior, s16 x, s16 y, s16 z, s16 ry, s16 params);
 void spawn_macro_abs_special(ModelID32 model, const BehaviorScript *behavior, s16 x, s16 y, s16 z, s16 unkA, s16 unkB, s16 unkC);
 
+struct Object *spawn_macro_object(MacroObject *macroObj);
 void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList);
 void spawn_macro_objects_hardcoded(s32 areaIndex, MacroObject *macroObjList);
 void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList);
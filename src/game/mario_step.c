@@ -273,6 +273,22 @@ s32 stationary_ground_step(struct MarioState *m) {
     return stepResult;
 }
 
+#ifdef ADAPTIVE_MARIO_STEPS
+/**
+ * Returns the number of steps needed to move the given squared distance
+ * without any single step moving further than MARIO_STEP_MAX_DIST.
+ */
+static s32 mario_get_num_steps(f32 distSq) {
+    s32 numSteps = 1;
+
+    while (numSteps < MARIO_STEP_MAX_STEPS && distSq > sqr(MARIO_STEP_MAX_DIST * numSteps)) {
+        numSteps++;
+    }
+
+    return numSteps;
+}
+#endif
+
 static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
     struct WallCollisionData lowerWall, upperWall;
     struct Surface *ceil, *floor;
@@ -348,11 +364,16 @@ s32 perform_ground_step(struct MarioState *m) {
     s32 i;
     u32 stepResult;
     Vec3f intendedPos;
-    const f32 numSteps = 4.0f;
+#ifdef ADAPTIVE_MARIO_STEPS
+    const s32 stepCount = mario_get_num_steps(sqr(m->floor->normal.y) * (sqr(m->vel[0]) + sqr(m->vel[2])));
+#else
+    const s32 stepCount = 4;
+#endif
+    const f32 numSteps = stepCount;
 
     set_mario_wall(m, NULL);
 
-    for (i = 0; i < 4; i++) {
+    for (i = 0; i < stepCount; i++) {
         intendedPos[0] = m->pos[0] + m->floor->normal.y * (m->vel[0] / numSteps);
         intendedPos[2] = m->pos[2] + m->floor->normal.y * (m->vel[2] / numSteps);
         intendedPos[1] = m->pos[1];
@@ -680,14 +701,19 @@ void apply_vertical_wind(struct MarioState *m) {
 
 s32 perform_air_step(struct MarioState *m, u32 stepArg) {
     Vec3f intendedPos;
-    const f32 numSteps = 4.0f;
+#ifdef ADAPTIVE_MARIO_STEPS
+    const s32 stepCount = mario_get_num_steps(vec3_sumsq(m->vel));
+#else
+    const s32 stepCount = 4;
+#endif
+    const f32 numSteps = stepCount;
     s32 i;
     s32 quarterStepResult;
     s32 stepResult = AIR_STEP_NONE;
 
     set_mario_wall(m, NULL);
 
-    for (i = 0; i < 4; i++) {
+    for (i = 0; i < stepCount; i++) {
         intendedPos[0] = m->pos[0] + m->vel[0] / numSteps;
         intendedPos[1] = m->pos[1] + m->vel[1] / numSteps;
         intendedPos[2] = m->pos[2] + m->vel[2] / numSteps;
@@ -0,0 +1,123 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "engine/math_util.h"
+#include "game_init.h"
+#include "matrix_cache.h"
+
+/**
+ * Keeps node matrices across frames.
+ *
+ * Entries are found by the node they belong to and the object being drawn (since model graphs are shared
+ * between objects), in a small window of an open addressed table. An entry is a hit if its node type,
+ * parent matrix version and transform all match, in which case its matrix is identical to the one that
+ * would be computed.
+ *
+ * Each entry has two fixed point matrices. When an entry's matrix changes, it's converted into the one
+ * that wasn't used last frame, so the RSP never reads a matrix that's being written.
+ */
+
+#ifdef MATRIX_CACHE
+
+/**
+ * How many entries are checked for a node before it gives up and rebuilds its matrix every frame.
+ */
+#define MATRIX_CACHE_PROBES 8
+
+static struct MatrixCacheEntry sMatrixCache[MATRIX_CACHE_ENTRIES];
+static u32 sMatrixCacheNextVersion = MATRIX_CACHE_VERSION_FIRST;
+
+static u32 matrix_cache_hash(void *node, void *object) {
+    u32 hash = ((uintptr_t) node >> 2) ^ ((uintptr_t) object << 3);
+
+    return ((hash * 2654435761U) >> 16);
+}
+
+static s32 matrix_cache_params_equal(Vec3f a[MATRIX_CACHE_NUM_PARAMS], Vec3f b[MATRIX_CACHE_NUM_PARAMS]) {
+    s32 i;
+
+    for (i = 0; i < MATRIX_CACHE_NUM_PARAMS; i++) {
+        if (a[i][0] != b[i][0] || a[i][1] != b[i][1] || a[i][2] != b[i][2]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Returns the cache entry for a node, or NULL if there's no room for it.
+ * hit is set if the entry's matrix can be used as is. Otherwise, the node's matrix
+ * has to be computed and stored in the entry with matrix_cache_store.
+ */
+struct MatrixCacheEntry *matrix_cache_get(void *node, void *object, s16 type, u32 parentVersion,
+                                          Vec3f params[MATRIX_CACHE_NUM_PARAMS], s32 *hit) {
+    struct MatrixCacheEntry *entry = NULL;
+    struct MatrixCacheEntry *oldest = NULL;
+    u32 start = matrix_cache_hash(node, object);
+    s32 i;
+
+    *hit = FALSE;
+
+    if (parentVersion == MATRIX_CACHE_VERSION_NONE) {
+        // The parent changes every frame, so this node would too.
+        return NULL;
+    }
+
+    for (i = 0; i < MATRIX_CACHE_PROBES; i++) {
+        struct MatrixCacheEntry *slot = &sMatrixCache[(start + i) % MATRIX_CACHE_ENTRIES];
+
+        if (slot->node == node && slot->object == object) {
+            entry = slot;
+            break;
+        }
+        // Entries used this frame may still be drawn, so they can't be taken.
+        if (slot->lastFrame != gGlobalTimer && (oldest == NULL || slot->lastFrame < oldest->lastFrame)) {
+            oldest = slot;
+        }
+    }
+
+    if (entry == NULL) {
+        if (oldest == NULL) {
+            return NULL;
+        }
+        entry = oldest;
+        entry->node = node;
+        entry->object = object;
+        entry->version = MATRIX_CACHE_VERSION_NONE;
+    } else if (entry->lastFrame == gGlobalTimer) {
+        // Drawn more than once this frame, like a shared model graph drawn twice for the same object.
+        // Only reuse the entry if it's identical, since the first matrix may still be drawn.
+        *hit = (entry->version != MATRIX_CACHE_VERSION_NONE && entry->type == type && entry->parentVersion == parentVersion
+                && matrix_cache_params_equal(entry->params, params));
+        return (*hit ? entry : NULL);
+    }
+
+    entry->lastFrame = gGlobalTimer;
+
+    if (entry->version != MATRIX_CACHE_VERSION_NONE && entry->type == type && entry->parentVersion == parentVersion
+        && matrix_cache_params_equal(entry->params, params)) {
+        *hit = TRUE;
+    } else {
+        // Not valid until matrix_cache_store is called, in case the matrix ends up not being stored.
+        entry->version = MATRIX_CACHE_VERSION_NONE;
+        entry->type = type;
+        entry->parentVersion = parentVersion;
+        bcopy(params, entry->params, sizeof(entry->params));
+    }
+
+    return entry;
+}
+
+/**
+ * Stores a newly computed matrix in an entry and returns its fixed point version.
+ */
+Mtx *matrix_cache_store(struct MatrixCacheEntry *entry, Mat4 mtxf) {
+    entry->buffer ^= 1;
+    entry->version = sMatrixCacheNextVersion++;
+    mtxf_copy(entry->mtxf, mtxf);
+    mtxf_to_mtx(&entry->mtx[entry->buffer], mtxf);
+
+    return &entry->mtx[entry->buffer];
+}
+
+#endif // MATRIX_CACHE
@@ -0,0 +1,43 @@
+#ifndef MATRIX_CACHE_H
+#define MATRIX_CACHE_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * Every matrix on the matrix stack has a version. Matrices with the same version are always identical,
+ * so a node's matrix only needs to be recomputed when its parent's version or its own transform changed.
+ */
+enum MatrixCacheVersions {
+    MATRIX_CACHE_VERSION_NONE, // Rebuilt every frame, so never identical to a previous frame's matrix.
+    MATRIX_CACHE_VERSION_ROOT, // The identity matrix at the bottom of the stack.
+    MATRIX_CACHE_VERSION_FIRST,
+};
+
+/**
+ * The transform of a node, in addition to its parent matrix.
+ */
+#define MATRIX_CACHE_NUM_PARAMS 3
+
+struct MatrixCacheEntry {
+    /*0x00*/ void *node;
+    /*0x04*/ void *object;
+    /*0x08*/ u32 parentVersion;
+    /*0x0C*/ u32 version;
+    /*0x10*/ u32 lastFrame;
+    /*0x14*/ s16 type;
+    /*0x16*/ u8 buffer;
+    /*0x18*/ Vec3f params[MATRIX_CACHE_NUM_PARAMS];
+    /*0x3C*/ Mat4 mtxf;
+    /*0x7C*/ u32 filler;
+    /*0x80*/ Mtx mtx[2];
+}; /*0x100*/
+
+#ifdef MATRIX_CACHE
+struct MatrixCacheEntry *matrix_cache_get(void *node, void *object, s16 type, u32 parentVersion,
+                                          Vec3f params[MATRIX_CACHE_NUM_PARAMS], s32 *hit);
+Mtx *matrix_cache_store(struct MatrixCacheEntry *entry, Mat4 mtxf);
+#endif
+
+#endif // MATRIX_CACHE_H
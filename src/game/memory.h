@@ -20,6 +20,17 @@ struct AllocOnlyPool {
 };
 
 struct MemoryPool;
+struct TlsfStats;
+struct SlabBlock;
+
+struct SlabPool {
+    u32 blockSize;
+    u32 numBlocks;
+    u32 numUsed;
+    u32 highWater;
+    u8 *start;
+    struct SlabBlock *freeList;
+};
 
 struct OffsetSizePair {
     u32 offset;
@@ -44,6 +55,7 @@ extern struct MemoryPool *gEffectsMemoryPool;
 
 uintptr_t set_segment_base_addr(s32 segment, void *addr);
 void *get_segment_base_addr(s32 segment);
+uintptr_t get_segment_rom_addr(s32 segment);
 void *segmented_to_virtual(const void *addr);
 void *virtual_to_segmented(u32 segment, const void *addr);
 void move_segment_table_to_dmem(void);
@@ -61,10 +73,25 @@ void *load_segment(s32 segment, u8 *srcStart, u8 *srcEnd, u32 side, u8 *bssStart
 void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd);
 void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd);
 void load_engine_code_segment(void);
+#ifdef SEGMENT_CACHE
+void segment_cache_init(void *start, void *end);
+void *load_segment_decompress_cached(s32 segment, u8 *srcStart, u8 *srcEnd);
+#else
+#define load_segment_decompress_cached load_segment_decompress
+#endif
+#ifdef STREAM_LEVEL_SEGMENTS
+extern u32 gStreamedSegmentsPending;
+
+void *load_segment_decompress_streamed(s32 segment, u8 *srcStart, u8 *srcEnd);
+void stream_require_segment(u32 segment);
+void stream_segments_update(void);
+void stream_segments_finish_all(void);
+#endif
 #else
 #define load_segment(...)
 #define load_to_fixed_pool_addr(...)
 #define load_segment_decompress(...)
+#define load_segment_decompress_cached(...)
 #define load_engine_code_segment(...)
 #endif
 
@@ -75,9 +102,16 @@ struct AllocOnlyPool *alloc_only_pool_resize(struct AllocOnlyPool *pool, u32 siz
 struct MemoryPool *mem_pool_init(u32 size, u32 side);
 void *mem_pool_alloc(struct MemoryPool *pool, u32 size);
 void mem_pool_free(struct MemoryPool *pool, void *addr);
+void mem_pool_get_stats(struct MemoryPool *pool, struct TlsfStats *stats);
+
+struct SlabPool *slab_pool_init(u32 blockSize, u32 numBlocks, u32 side);
+void *slab_pool_alloc(struct SlabPool *pool);
+void slab_pool_free(struct SlabPool *pool, void *addr);
 
 void *alloc_display_list(u32 size);
 void setup_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buffer);
 s32 load_patchable_table(struct DmaHandlerList *list, s32 index);
+void set_segment_rom_resident(s32 segment, u8 *srcStart);
+void rom_segment_read(void *dest, const void *addr, u32 size);
 
 #endif // MEMORY_H
@@ -13,6 +13,7 @@
 #include "geo_misc.h"
 #include "rendering_graph_node.h"
 #include "object_list_processor.h"
+#include "game_init.h"
 
 /**
  * This file contains functions for generating display lists with moving textures
@@ -48,6 +49,13 @@
  * which will then be matched with the id of entries in gEnvironmentRegions to get the
  * y-position. The x and z coordinates are stored in the MovtexQuads themself,
  * so the water rectangle is separate from the actually drawn rectangle.
+ *
+ * Since usually only the texture coordinates change from frame to frame, the
+ * vertices of both systems are kept in caches that persist across frames instead
+ * of being allocated from the display list pool. Each cache entry has two vertex
+ * buffers, alternating every frame, so the RSP never reads a vertex that's being
+ * written. A buffer is fully rewritten when what it was last written with changes
+ * (like the water level in Wet-Dry World), otherwise only its texture coordinates are.
  */
 
 // First entry in array is texture movement speed for both layouts
@@ -128,6 +136,52 @@ float gPaintingMarioYEntry = 0.0f;
 /// Variable to ensure the initial Wet-Dry World water level is set only once
 s32 gWdwWaterLevelSet = FALSE;
 
+/// The maximum number of MovtexQuads that can be drawn per frame with cached vertices.
+/// Quads past this get new vertices every frame.
+#define MOVTEX_QUAD_CACHE_SIZE 64
+/// The maximum number of MovtexObjects with cached vertices.
+#define MOVTEX_MESH_CACHE_SIZE 16
+/// The maximum amount of vertices in a MovtexObject, since they all have to fit in the RSP's vertex buffer.
+#define MOVTEX_MESH_MAX_VERTICES 16
+
+/**
+ * Cached vertices for a MovtexQuad. Quads are drawn in the same order every frame,
+ * so the n-th quad drawn in a frame uses the n-th entry.
+ */
+struct MovtexQuadCache {
+    /// The quad, height and color each buffer was last fully written with
+    struct MovtexQuad *quad[2];
+    s16 y[2];
+    s8 vtxColor[2];
+    Vtx verts[2][4];
+};
+
+/**
+ * Cached vertices for a MovtexObject. All instances of a MovtexObject drawn in a frame
+ * are identical, so they share one entry.
+ */
+struct MovtexMeshCache {
+    struct MovtexObject *object;
+    /// The mesh each buffer was last fully written with
+    s16 *movtexVerts[2];
+    Vtx verts[2][MOVTEX_MESH_MAX_VERTICES];
+};
+
+static struct MovtexQuadCache sMovtexQuadCache[MOVTEX_QUAD_CACHE_SIZE];
+static struct MovtexMeshCache sMovtexMeshCache[MOVTEX_MESH_CACHE_SIZE];
+static s32 sMovtexNumMeshCaches = 0;
+static s32 sMovtexQuadCacheCursor = 0;
+static u32 sMovtexQuadCacheFrame = 0;
+
+/**
+ * Forget every cached vertex, since the same addresses may hold different meshes after a load.
+ */
+static void movtex_clear_vertex_caches(void) {
+    bzero(sMovtexQuadCache, sizeof(sMovtexQuadCache));
+    sMovtexNumMeshCaches = 0;
+    sMovtexQuadCacheCursor = 0;
+}
+
 extern Texture ssl_quicksand[];
 extern Texture ssl_pyramid_sand[];
 extern Texture ttc_yellow_triangle[];
@@ -285,6 +339,7 @@ Gfx *geo_movtex_pause_control(s32 callContext, UNUSED struct GraphNode *node, UN
     if (callContext != GEO_CONTEXT_RENDER) {
         gMovtexCounterPrev = gAreaUpdateCounter - 1;
         gMovtexCounter = gAreaUpdateCounter;
+        movtex_clear_vertex_caches();
     } else {
         gMovtexCounterPrev = gMovtexCounter;
         gMovtexCounter = gAreaUpdateCounter;
@@ -345,6 +400,41 @@ struct MovtexQuad {
 /// Variable for a little optimization: only set the texture when it differs from the previous texture
 s16 gMovetexLastTextureId;
 
+/**
+ * Only update the texture coordinates of a vertex made with movtex_make_quad_vertex.
+ */
+static void movtex_set_quad_vertex_uv(Vtx *verts, s32 index, s16 rot, s16 rotOffset, f32 scale) {
+    scale = 32.0f * ((32.0f * scale) - 1.0f);
+    verts[index].v.tc[0] = scale * sins(rot + rotOffset);
+    verts[index].v.tc[1] = scale * coss(rot + rotOffset);
+}
+
+/**
+ * Returns this frame's vertex buffer for the next quad, or NULL if the cache is full.
+ * needsFullWrite is set if the buffer wasn't last written with this quad at this height and color,
+ * otherwise only the texture coordinates need to be updated.
+ */
+static Vtx *movtex_get_cached_quad_verts(struct MovtexQuad *quad, s16 y, s32 *needsFullWrite) {
+    s32 buffer = (gGlobalTimer & 1);
+    struct MovtexQuadCache *cache;
+
+    if (sMovtexQuadCacheFrame != gGlobalTimer) {
+        sMovtexQuadCacheFrame = gGlobalTimer;
+        sMovtexQuadCacheCursor = 0;
+    }
+    if (sMovtexQuadCacheCursor >= MOVTEX_QUAD_CACHE_SIZE) {
+        return NULL;
+    }
+
+    cache = &sMovtexQuadCache[sMovtexQuadCacheCursor++];
+    *needsFullWrite = (cache->quad[buffer] != quad || cache->y[buffer] != y || cache->vtxColor[buffer] != gMovtexVtxColor);
+    cache->quad[buffer] = quad;
+    cache->y[buffer] = y;
+    cache->vtxColor[buffer] = gMovtexVtxColor;
+
+    return cache->verts[buffer];
+}
+
 /**
  * Generates and returns a display list for a single MovtexQuad at height y.
  */
@@ -363,10 +453,16 @@ Gfx *movtex_gen_from_quad(s16 y, struct MovtexQuad *quad) {
     s16 rotDir = quad->rotDir;
     s16 alpha = quad->alpha;
     s16 textureId = quad->textureId;
-    Vtx *verts = alloc_display_list(4 * sizeof(*verts));
+    s16 rotOffset = (rotDir == ROTATE_CLOCKWISE) ? 0x4000 : -0x4000;
+    s32 needsFullWrite = TRUE;
+    Vtx *verts = movtex_get_cached_quad_verts(quad, y, &needsFullWrite);
     Gfx *gfxHead;
     Gfx *gfx;
 
+    if (verts == NULL) {
+        verts = alloc_display_list(4 * sizeof(*verts));
+    }
+
     if (textureId == gMovetexLastTextureId) {
         gfxHead = alloc_display_list(3 * sizeof(*gfxHead));
     } else {
@@ -381,16 +477,17 @@ Gfx *movtex_gen_from_quad(s16 y, struct MovtexQuad *quad) {
         quad->rot += rotspeed;
     }
     rot = quad->rot;
-    if (rotDir == ROTATE_CLOCKWISE) {
-        movtex_make_quad_vertex(verts, 0, x1, y, z1, rot,  0x0000, scale, alpha);
-        movtex_make_quad_vertex(verts, 1, x2, y, z2, rot,  0x4000, scale, alpha);
-        movtex_make_quad_vertex(verts, 2, x3, y, z3, rot, -0x8000, scale, alpha);
-        movtex_make_quad_vertex(verts, 3, x4, y, z4, rot, -0x4000, scale, alpha);
-    } else { // ROTATE_COUNTER_CLOCKWISE
-        movtex_make_quad_vertex(verts, 0, x1, y, z1, rot,  0x0000, scale, alpha);
-        movtex_make_quad_vertex(verts, 1, x2, y, z2, rot, -0x4000, scale, alpha);
-        movtex_make_quad_vertex(verts, 2, x3, y, z3, rot, -0x8000, scale, alpha);
-        movtex_make_quad_vertex(verts, 3, x4, y, z4, rot,  0x4000, scale, alpha);
+    // The second and fourth vertex swap rotation offsets for ROTATE_COUNTER_CLOCKWISE.
+    if (needsFullWrite) {
+        movtex_make_quad_vertex(verts, 0, x1, y, z1, rot,     0x0000, scale, alpha);
+        movtex_make_quad_vertex(verts, 1, x2, y, z2, rot,  rotOffset, scale, alpha);
+        movtex_make_quad_vertex(verts, 2, x3, y, z3, rot,    -0x8000, scale, alpha);
+        movtex_make_quad_vertex(verts, 3, x4, y, z4, rot, -rotOffset, scale, alpha);
+    } else {
+        movtex_set_quad_vertex_uv(verts, 0, rot,     0x0000, scale);
+        movtex_set_quad_vertex_uv(verts, 1, rot,  rotOffset, scale);
+        movtex_set_quad_vertex_uv(verts, 2, rot,    -0x8000, scale);
+        movtex_set_quad_vertex_uv(verts, 3, rot, -rotOffset, scale);
     }
 
     // Only add commands to change the texture when necessary
@@ -719,23 +816,85 @@ void movtex_write_vertex_index(Vtx *verts, s32 index, s16 *movtexVerts, struct M
     }
 }
 
+/**
+ * Only update the texture coordinates of vertices made with movtex_write_vertex_first
+ * and movtex_write_vertex_index. Only the texture coordinates of a mesh are animated.
+ */
+static void movtex_update_vertex_uvs(Vtx *verts, s16 *movtexVerts, s32 vtxCount, s8 attrLayout) {
+    s32 stride = (attrLayout == MOVTEX_LAYOUT_NOCOLOR) ? 5 : 8;
+    s32 attrS  = (attrLayout == MOVTEX_LAYOUT_NOCOLOR) ? MOVTEX_ATTR_NOCOLOR_S : MOVTEX_ATTR_COLORED_S;
+    s16 baseS = movtexVerts[attrS];
+    s16 baseT = movtexVerts[attrS + 1];
+    s32 i;
+
+    verts[0].v.tc[0] = baseS;
+    verts[0].v.tc[1] = baseT;
+    for (i = 1; i < vtxCount; i++) {
+        verts[i].v.tc[0] = baseS + ((movtexVerts[(i * stride) + attrS    ] * 32) * 32U);
+        verts[i].v.tc[1] = baseT + ((movtexVerts[(i * stride) + attrS + 1] * 32) * 32U);
+    }
+}
+
+/**
+ * Returns the vertex cache for a MovtexObject, or NULL if there's no room for it.
+ */
+static struct MovtexMeshCache *movtex_get_mesh_cache(struct MovtexObject *movtexList) {
+    struct MovtexMeshCache *cache;
+    s32 i;
+
+    if (movtexList->vtx_count > MOVTEX_MESH_MAX_VERTICES) {
+        return NULL;
+    }
+
+    for (i = 0; i < sMovtexNumMeshCaches; i++) {
+        if (sMovtexMeshCache[i].object == movtexList) {
+            return &sMovtexMeshCache[i];
+        }
+    }
+
+    if (sMovtexNumMeshCaches >= MOVTEX_MESH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    cache = &sMovtexMeshCache[sMovtexNumMeshCaches++];
+    cache->object = movtexList;
+    cache->movtexVerts[0] = NULL;
+    cache->movtexVerts[1] = NULL;
+    return cache;
+}
+
 /**
  * Generate a displaylist for a MovtexObject.
  * 'attrLayout' is one of MOVTEX_LAYOUT_NOCOLOR and MOVTEX_LAYOUT_COLORED.
  */
 Gfx *movtex_gen_list(s16 *movtexVerts, struct MovtexObject *movtexList, s8 attrLayout) {
-    Vtx *verts = alloc_display_list(movtexList->vtx_count * sizeof(*verts));
+    struct MovtexMeshCache *cache = movtex_get_mesh_cache(movtexList);
+    s32 buffer = (gGlobalTimer & 1);
+    Vtx *verts;
     Gfx *gfxHead = alloc_display_list(11 * sizeof(*gfxHead));
     Gfx *gfx = gfxHead;
     s32 i;
 
+    if (cache != NULL) {
+        verts = cache->verts[buffer];
+    } else {
+        verts = alloc_display_list(movtexList->vtx_count * sizeof(*verts));
+    }
+
     if (verts == NULL || gfxHead == NULL) {
         return NULL;
     }
 
-    movtex_write_vertex_first(verts, movtexVerts, movtexList, attrLayout);
-    for (i = 1; i < movtexList->vtx_count; i++) {
-        movtex_write_vertex_index(verts, i, movtexVerts, movtexList, attrLayout);
+    if (cache != NULL && cache->movtexVerts[buffer] == movtexVerts) {
+        movtex_update_vertex_uvs(verts, movtexVerts, movtexList->vtx_count, attrLayout);
+    } else {
+        movtex_write_vertex_first(verts, movtexVerts, movtexList, attrLayout);
+        for (i = 1; i < movtexList->vtx_count; i++) {
+            movtex_write_vertex_index(verts, i, movtexVerts, movtexList, attrLayout);
+        }
+        if (cache != NULL) {
+            cache->movtexVerts[buffer] = movtexVerts;
+        }
     }
 
     gSPDisplayList(gfx++, movtexList->beginDl);
@@ -48,12 +48,6 @@
 
 //! TODO: remove static
 
-enum ObjPositionOperation {
-    POS_OP_SAVE_POSITION,
-    POS_OP_COMPUTE_VELOCITY,
-    POS_OP_RESTORE_POSITION
-};
-
 Vec3f sObjSavedPos;
 
 void wiggler_jumped_on_attack_handler(void);
@@ -90,7 +84,7 @@ static s32 obj_update_race_proposition_dialog(s16 dialogID) {
     return dialogResponse;
 }
 
-static void obj_set_dist_from_home(f32 distFromHome) {
+void obj_set_dist_from_home(f32 distFromHome) {
     o->oPosX = o->oHomeX + distFromHome * coss(o->oMoveAngleYaw);
     o->oPosZ = o->oHomeZ + distFromHome * sins(o->oMoveAngleYaw);
 }
@@ -103,7 +97,7 @@ static s32 obj_is_near_to_and_facing_mario(f32 maxDist, s16 maxAngleDiff) {
     return FALSE;
 }
 
-static void obj_perform_position_op(s32 op) {
+void obj_perform_position_op(s32 op) {
     switch (op) {
         case POS_OP_SAVE_POSITION:    vec3f_copy(sObjSavedPos, &o->oPosVec); break;
         case POS_OP_COMPUTE_VELOCITY: vec3f_diff(&o->oVelVec, &o->oPosVec, sObjSavedPos); break;
@@ -187,7 +181,7 @@ static s32 clamp_s16(s16 *value, s16 minimum, s16 maximum) {
     return TRUE;
 }
 
-static s32 clamp_f32(f32 *value, f32 minimum, f32 maximum) {
+s32 clamp_f32(f32 *value, f32 minimum, f32 maximum) {
     if (*value <= minimum) {
         *value = minimum;
     } else if (*value >= maximum) {
@@ -247,7 +241,7 @@ static s16 obj_turn_pitch_toward_mario(f32 targetOffsetY, s16 turnAmount) {
     return targetPitch;
 }
 
-static s32 approach_f32_ptr(f32 *px, f32 target, f32 delta) {
+s32 approach_f32_ptr(f32 *px, f32 target, f32 delta) {
     if (*px > target) {
         delta = -delta;
     }
@@ -289,7 +283,7 @@ static s32 obj_face_pitch_approach(s16 targetPitch, s16 deltaPitch) {
     return FALSE;
 }
 
-static s32 obj_face_yaw_approach(s16 targetYaw, s16 deltaYaw) {
+s32 obj_face_yaw_approach(s16 targetYaw, s16 deltaYaw) {
     o->oFaceAngleYaw = approach_s16_symmetric(o->oFaceAngleYaw, targetYaw, deltaYaw);
 
     if ((s16) o->oFaceAngleYaw == targetYaw) {
@@ -299,7 +293,7 @@ static s32 obj_face_yaw_approach(s16 targetYaw, s16 deltaYaw) {
     return FALSE;
 }
 
-static s32 obj_face_roll_approach(s16 targetRoll, s16 deltaRoll) {
+s32 obj_face_roll_approach(s16 targetRoll, s16 deltaRoll) {
     o->oFaceAngleRoll = approach_s16_symmetric(o->oFaceAngleRoll, targetRoll, deltaRoll);
 
     if ((s16) o->oFaceAngleRoll == targetRoll) {
@@ -329,11 +323,11 @@ static void obj_roll_to_match_yaw_turn(s16 targetYaw, s16 maxRoll, s16 rollSpeed
     obj_face_roll_approach(targetRoll, rollSpeed);
 }
 
-static s16 random_linear_offset(s16 base, s16 range) {
+s16 random_linear_offset(s16 base, s16 range) {
     return base + (s16)(range * random_float());
 }
 
-static s16 random_mod_offset(s16 base, s16 step, s16 mod) {
+s16 random_mod_offset(s16 base, s16 step, s16 mod) {
     return base + step * (random_u16() % mod);
 }
 
@@ -764,15 +758,6 @@ static void treat_far_home_as_mario(f32 threshold) {
 #include "behaviors/seesaw_platform.inc.c"
 #include "behaviors/ferris_wheel.inc.c"
 #include "behaviors/water_bomb.inc.c" // TODO: Shadow position
-#include "behaviors/ttc_rotating_solid.inc.c"
-#include "behaviors/ttc_pendulum.inc.c"
-#include "behaviors/ttc_treadmill.inc.c" // TODO
-#include "behaviors/ttc_moving_bar.inc.c"
-#include "behaviors/ttc_cog.inc.c"
-#include "behaviors/ttc_pit_block.inc.c"
-#include "behaviors/ttc_elevator.inc.c"
-#include "behaviors/ttc_2d_rotator.inc.c"
-#include "behaviors/ttc_spinner.inc.c"
 #include "behaviors/mr_blizzard.inc.c"
 #include "behaviors/sliding_platform_2.inc.c"
 #include "behaviors/rotating_octagonal_plat.inc.c"
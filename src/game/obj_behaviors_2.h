@@ -22,4 +22,20 @@ void obj_spit_fire(s16 relativePosX, s16 relativePosY, s16 relativePosZ, f32 sca
                    f32 startSpeed, f32 endSpeed, s16 movePitch);
 void obj_set_speed_to_zero(void);
 
+// Helpers also used by the behaviors in src/overlays/.
+enum ObjPositionOperation {
+    POS_OP_SAVE_POSITION,
+    POS_OP_COMPUTE_VELOCITY,
+    POS_OP_RESTORE_POSITION
+};
+
+void obj_set_dist_from_home(f32 distFromHome);
+void obj_perform_position_op(s32 op);
+s32 clamp_f32(f32 *value, f32 minimum, f32 maximum);
+s32 approach_f32_ptr(f32 *px, f32 target, f32 delta);
+s32 obj_face_yaw_approach(s16 targetYaw, s16 deltaYaw);
+s32 obj_face_roll_approach(s16 targetRoll, s16 deltaRoll);
+s16 random_linear_offset(s16 base, s16 range);
+s16 random_mod_offset(s16 base, s16 step, s16 mod);
+
 #endif // OBJ_BEHAVIORS_2_H
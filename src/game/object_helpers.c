@@ -885,6 +885,31 @@ void obj_mark_for_deletion(struct Object *obj) {
     obj->activeFlags = ACTIVE_FLAG_DEACTIVATED;
 }
 
+/**
+ * Attach a block of size bytes to an object, for data that doesn't fit in its object fields.
+ * Sidecars all come from one slab of OBJECT_SIDECAR_SIZE blocks, so objects that come and go
+ * don't fragment gObjectMemoryPool. An object can have one sidecar at a time, and it is freed
+ * when the object unloads if the behavior doesn't free it first.
+ * Return NULL if every sidecar is in use.
+ */
+void *obj_alloc_sidecar(struct Object *obj, u32 size) {
+    assert(size <= gObjectSidecarPool->blockSize, "Object sidecar is larger than OBJECT_SIDECAR_SIZE!");
+    assert(obj->sidecar == NULL, "Object already has a sidecar!");
+
+    obj->sidecar = slab_pool_alloc(gObjectSidecarPool);
+    return obj->sidecar;
+}
+
+/**
+ * Free an object's sidecar before it unloads, so it can be reused.
+ */
+void obj_free_sidecar(struct Object *obj) {
+    if (obj->sidecar != NULL) {
+        slab_pool_free(gObjectSidecarPool, obj->sidecar);
+        obj->sidecar = NULL;
+    }
+}
+
 void cur_obj_disable(void) {
     cur_obj_disable_rendering();
     cur_obj_hide();
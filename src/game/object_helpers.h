@@ -145,6 +145,9 @@ s32 cur_obj_clear_interact_status_flag(s32 flag);
 void obj_mark_for_deletion(struct Object *obj);
 // Hackersm64 backwards compatibility
 #define mark_obj_for_deletion obj_mark_for_deletion
+void *obj_alloc_sidecar(struct Object *obj, u32 size);
+void obj_free_sidecar(struct Object *obj);
+#define obj_alloc_sidecar_array(obj, type, count) ((type *) obj_alloc_sidecar((obj), (count) * sizeof(type)))
 void cur_obj_disable(void);
 void cur_obj_become_intangible(void);
 void cur_obj_become_tangible(void);
@@ -11,6 +11,7 @@
 #include "engine/surface_load.h"
 #include "engine/math_util.h"
 #include "interaction.h"
+#include "lazy_spawn.h"
 #include "level_update.h"
 #include "mario.h"
 #include "memory.h"
@@ -20,7 +21,10 @@
 #include "platform_displacement.h"
 #include "spawn_object.h"
 #include "puppyprint.h"
+#include "room_visibility.h"
 #include "profiling.h"
+#include "event_trace.h"
+#include "behavior_profiler.h"
 
 
 /**
@@ -143,6 +147,12 @@ s32 gNumStaticSurfaces;
  */
 struct MemoryPool *gObjectMemoryPool;
 
+/**
+ * Fixed-size blocks for per-object data that doesn't fit in the object fields, such as
+ * chain segments. See obj_alloc_sidecar.
+ */
+struct SlabPool *gObjectSidecarPool;
+
 s16 gCollisionFlags = COLLISION_FLAGS_NONE;
 TerrainData *gEnvironmentRegions;
 s32 gEnvironmentLevels[20];
@@ -293,7 +303,11 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         gCurrentObject = (struct Object *) firstObj;
 
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+        TRACE_BEGIN(TRACE_EVENT_OBJECT_UPDATE, gCurrentObject->behavior);
+        behavior_profiler_begin(gCurrentObject->behavior);
         cur_obj_update();
+        behavior_profiler_end();
+        TRACE_END(TRACE_EVENT_OBJECT_UPDATE, gCurrentObject->behavior);
 
         firstObj = firstObj->next;
         count++;
@@ -340,7 +354,11 @@ s32 update_objects_during_time_stop(struct ObjectNode *objList, struct ObjectNod
         // Only update if unfrozen
         if (unfrozen) {
             gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+            TRACE_BEGIN(TRACE_EVENT_OBJECT_UPDATE, gCurrentObject->behavior);
+            behavior_profiler_begin(gCurrentObject->behavior);
             cur_obj_update();
+            behavior_profiler_end();
+            TRACE_END(TRACE_EVENT_OBJECT_UPDATE, gCurrentObject->behavior);
         } else {
             gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_HAS_ANIMATION;
         }
@@ -443,6 +461,46 @@ void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex) {
     }
 }
 
+/**
+ * Spawn a single object from its SpawnInfo.
+ */
+struct Object *spawn_object_from_spawn_info(struct SpawnInfo *spawnInfo) {
+    const BehaviorScript *script = segmented_to_virtual(spawnInfo->behaviorScript);
+    struct Object *object = create_object(script);
+
+    // Behavior parameters are often treated as four separate bytes, but
+    // are stored as an s32.
+    object->oBehParams = spawnInfo->behaviorArg;
+    // The second byte of the behavior parameters is copied over to a special field
+    // as it is the most frequently used by objects.
+    object->oBehParams2ndByte = GET_BPARAM2(spawnInfo->behaviorArg);
+
+    object->behavior = script;
+
+    // Record death/collection in the SpawnInfo
+    object->respawnInfoType = RESPAWN_INFO_TYPE_NORMAL;
+    object->respawnInfo = &spawnInfo->behaviorArg;
+
+    // Usually this checks if bparam4 is 1 to decide if this is mario
+    // This change allows any object to use that param
+    if (object->behavior == segmented_to_virtual(bhvMario)) {
+        gMarioObject = object;
+        geo_make_first_child(&object->header.gfx.node);
+    }
+
+    geo_obj_init_spawninfo(&object->header.gfx, spawnInfo);
+
+    vec3s_to_vec3f(&object->oPosVec, spawnInfo->startPos);
+
+    vec3s_to_vec3i(&object->oFaceAngleVec, spawnInfo->startAngle);
+
+    vec3s_to_vec3i(&object->oMoveAngleVec, spawnInfo->startAngle);
+
+    object->oFloorHeight = find_floor(object->oPosX, object->oPosY, object->oPosZ, &object->oFloor);
+
+    return object;
+}
+
 /**
  * Spawn objects given a list of SpawnInfos. Called when loading an area.
  */
@@ -460,46 +518,15 @@ void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo) {
     }
 
     while (spawnInfo != NULL) {
-        struct Object *object;
-        const BehaviorScript *script;
-
-        script = segmented_to_virtual(spawnInfo->behaviorScript);
-
         // If the object was previously killed/collected, don't respawn it
         if ((spawnInfo->behaviorArg & (RESPAWN_INFO_DONT_RESPAWN << 8))
             != (RESPAWN_INFO_DONT_RESPAWN << 8)) {
-            object = create_object(script);
-
-            // Behavior parameters are often treated as four separate bytes, but
-            // are stored as an s32.
-            object->oBehParams = spawnInfo->behaviorArg;
-            // The second byte of the behavior parameters is copied over to a special field
-            // as it is the most frequently used by objects.
-            object->oBehParams2ndByte = GET_BPARAM2(spawnInfo->behaviorArg);
-
-            object->behavior = script;
-            object->unused1 = 0;
-
-            // Record death/collection in the SpawnInfo
-            object->respawnInfoType = RESPAWN_INFO_TYPE_NORMAL;
-            object->respawnInfo = &spawnInfo->behaviorArg;
-
-            // Usually this checks if bparam4 is 1 to decide if this is mario
-            // This change allows any object to use that param
-            if (object->behavior == segmented_to_virtual(bhvMario)) {
-                gMarioObject = object;
-                geo_make_first_child(&object->header.gfx.node);
+            // With lazy spawning, objects in streamable lists are added to the spawn index instead,
+            // and get spawned once Mario or the camera come within range.
+            if (!lazy_spawn_defer(LAZY_SPAWN_TYPE_SPAWN_INFO, spawnInfo, spawnInfo->behaviorScript,
+                                  spawnInfo->startPos[0], spawnInfo->startPos[2])) {
+                spawn_object_from_spawn_info(spawnInfo);
             }
-
-            geo_obj_init_spawninfo(&object->header.gfx, spawnInfo);
-
-            vec3s_to_vec3f(&object->oPosVec, spawnInfo->startPos);
-
-            vec3s_to_vec3i(&object->oFaceAngleVec, spawnInfo->startAngle);
-
-            vec3s_to_vec3i(&object->oMoveAngleVec, spawnInfo->startAngle);
-
-            object->oFloorHeight = find_floor(object->oPosX, object->oPosY, object->oPosZ, &object->oFloor);
         }
 
         spawnInfo = spawnInfo->next;
@@ -518,6 +545,7 @@ void clear_objects(void) {
     gMarioCurrentRoom = 0;
 
     bzero(gDoorAdjacentRooms, sizeof(gDoorAdjacentRooms));
+    room_visibility_reset();
 
     debug_unknown_level_select_check();
 
@@ -530,6 +558,7 @@ void clear_objects(void) {
     }
 
     gObjectMemoryPool = mem_pool_init(OBJECT_MEMORY_POOL, MEMORY_POOL_LEFT);
+    gObjectSidecarPool = slab_pool_init(OBJECT_SIDECAR_SIZE, OBJECT_SIDECAR_COUNT, MEMORY_POOL_LEFT);
     gObjectLists = gObjectListArray;
 
     clear_dynamic_surfaces();
@@ -647,6 +676,9 @@ void update_objects(UNUSED s32 unused) {
     // If time stop is not active, unload object surfaces
     clear_dynamic_surfaces();
 
+    // Spawn and despawn streamed area objects around Mario and the camera
+    lazy_spawn_update();
+
     // Update spawners and objects with surfaces
     update_terrain_objects();
 
@@ -98,7 +98,12 @@ extern s32 gNumStaticSurfaces;
 
 #define OBJECT_MEMORY_POOL 0x800
 
+// Size and number of the fixed-size blocks objects can attach with obj_alloc_sidecar.
+#define OBJECT_SIDECAR_SIZE  0x80
+#define OBJECT_SIDECAR_COUNT 16
+
 extern struct MemoryPool *gObjectMemoryPool;
+extern struct SlabPool *gObjectSidecarPool;
 
 enum CollisionFlags {
     COLLISION_FLAGS_NONE              = (0 << 0),
@@ -139,6 +144,7 @@ extern s16 gMarioOnMerryGoRound;
 void bhv_mario_update(void);
 void set_object_respawn_info_bits(struct Object *obj, u8 bits);
 void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex);
+struct Object *spawn_object_from_spawn_info(struct SpawnInfo *spawnInfo);
 void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo);
 void clear_objects(void);
 void clear_dynamic_surface_references(void);
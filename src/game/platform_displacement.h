@@ -16,6 +16,8 @@ struct PlatformDisplacementInfo {
     u32 prevTimer;
 };
 
+extern struct Object *gMarioPlatform;
+
 void update_mario_platform(void);
 void update_platform_displacement_info(struct PlatformDisplacementInfo *displaceInfo, Vec3f pos, s16 yaw, struct Object *platform);
 void apply_platform_displacement(struct PlatformDisplacementInfo *displaceInfo, Vec3f pos, s16 *yaw, struct Object *platform);
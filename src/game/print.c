@@ -5,6 +5,7 @@
 #include "memory.h"
 #include "print.h"
 #include "segment2.h"
+#include "text_batch.h"
 
 /**
  * This file handles printing and formatting the colorful text that
@@ -412,9 +413,24 @@ void render_textrect(s32 x, s32 y, s32 pos) {
                         (rectY + 15) << 2, G_TX_RENDERTILE, 0, 0, 4 << 10, 1 << 10);
 }
 
+/**
+ * Queues the glyph at the given position, like add_glyph_texture and render_textrect.
+ */
+static void add_textrect_glyph(s8 glyphIndex, s32 x, s32 y, s32 pos, u8 layer) {
+    const Texture *const *glyphs = segmented_to_virtual(main_hud_lut);
+    s32 rectBaseX = x + pos * 12;
+    s32 rectBaseY = 224 - y;
+
+#ifndef WIDESCREEN
+    // For widescreen we must allow drawing outside the usual area
+    clip_to_bounds(&rectBaseX, &rectBaseY);
+#endif
+    text_batch_add(glyphs[glyphIndex], rectBaseX, rectBaseY, layer, TRUE, 0);
+}
+
 /**
  * Renders the text in sTextLabels on screen at the proper locations by iterating
- * a for loop.
+ * a for loop. Glyphs are batched, so each glyph's texture is only loaded once.
  */
 void render_text_labels(void) {
     s32 i;
@@ -437,6 +453,8 @@ void render_text_labels(void) {
     gSPPerspNormalize((Gfx *) (gDisplayListHead++), 0xFFFF);
     gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(mtx), G_MTX_PROJECTION | G_MTX_LOAD | G_MTX_NOPUSH);
     gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
+    // HUD glyphs are drawn in copy mode and never set a color, so the env color is unused.
+    text_batch_begin(TEXT_BATCH_HUD_RECTS, TEXT_BATCH_COLOR(255, 255, 255, 255));
 
     for (i = 0; i < sTextLabelsCount; i++) {
         for (j = 0; j < sTextLabels[i]->length; j++) {
@@ -447,18 +465,13 @@ void render_text_labels(void) {
                 // Beta Key was removed by EU, so glyph slot reused.
                 // This produces a colorful Ü.
                 if (glyphIndex == GLYPH_BETA_KEY) {
-                    add_glyph_texture(GLYPH_U);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
-
-                    add_glyph_texture(GLYPH_UMLAUT);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y + 3, j);
+                    add_textrect_glyph(GLYPH_U, sTextLabels[i]->x, sTextLabels[i]->y, j, TEXT_BATCH_LAYER_BASE);
+                    add_textrect_glyph(GLYPH_UMLAUT, sTextLabels[i]->x, sTextLabels[i]->y + 3, j, TEXT_BATCH_LAYER_OVERLAY);
                 } else {
-                    add_glyph_texture(glyphIndex);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
+                    add_textrect_glyph(glyphIndex, sTextLabels[i]->x, sTextLabels[i]->y, j, TEXT_BATCH_LAYER_BASE);
                 }
 #else
-                add_glyph_texture(glyphIndex);
-                render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
+                add_textrect_glyph(glyphIndex, sTextLabels[i]->x, sTextLabels[i]->y, j, TEXT_BATCH_LAYER_BASE);
 #endif
             }
         }
@@ -466,6 +479,7 @@ void render_text_labels(void) {
         mem_pool_free(gEffectsMemoryPool, sTextLabels[i]);
     }
 
+    text_batch_end();
     gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
 
     sTextLabelsCount = 0;
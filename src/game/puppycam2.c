@@ -54,6 +54,18 @@ u16 gPuppyVolumeCount = 0;
 struct MemoryPool *gPuppyMemoryPool;
 s32 gPuppyError = 0;
 
+// The maximum number of (volume, cell) pairs in the volume grid. If an area's volumes cover more cells
+// than this, every volume is checked each frame instead.
+#define PUPPYCAM_VOLUME_GRID_ENTRIES 1024
+
+// Volumes in the current area, binned into the same XZ cells as collision.
+// The volumes overlapping cell i are sPuppyVolumeCellList[sPuppyVolumeCellStart[i]] up to sPuppyVolumeCellStart[i + 1].
+static u16 sPuppyVolumeCellStart[(NUM_CELLS * NUM_CELLS) + 1];
+static u8  sPuppyVolumeCellList[PUPPYCAM_VOLUME_GRID_ENTRIES]; // Indices into sPuppyVolumeStack, so MAX_PUPPYCAM_VOLUMES can't exceed 256.
+static s16 sPuppyVolumeGridArea = -1;
+static u16 sPuppyVolumeGridCount = 0;
+static u8  sPuppyVolumeGridValid = FALSE;
+
 #if defined(VERSION_EU)
 static unsigned char  gPCOptionStringsFR[][64] = {{NC_ANALOGUE_FR}, {NC_CAMX_FR}, {NC_INVERTX_FR}, {NC_CAMC_FR}, {NC_SCHEME_FR}, {NC_WIDE_FR}, {OPTION_LANGUAGE_FR}};
 static unsigned char  gPCOptionStringsDE[][64] = {{NC_ANALOGUE_DE}, {NC_CAMX_DE}, {NC_INVERTX_DE}, {NC_CAMC_DE}, {NC_SCHEME_DE}, {NC_WIDE_DE}, {OPTION_LANGUAGE_DE}};
@@ -325,12 +337,12 @@ void puppycam_change_setting(s8 toggle) {
 
 void puppycam_print_text(s32 x, s32 y, unsigned char *str, s32 col) {
     s32 textX = get_str_x_pos_from_center(x, str, 10.0f);
-    gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, 255);
+    set_text_env_color(0, 0, 0, 255);
     print_generic_string(textX + 1, y - 1,str);
     if (col != 0) {
-        gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+        set_text_env_color(255, 255, 255, 255);
     } else {
-        gDPSetEnvColor(gDisplayListHead++, 255,  32,  32, 255);
+        set_text_env_color(255,  32,  32, 255);
     }
     print_generic_string(textX,y,str);
 }
@@ -354,7 +366,7 @@ void puppycam_display_options() {
 
     puppycam_display_box(48,84,272,218,0x0,0x0,0x0, 0x50);
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+    set_text_env_color(255, 255, 255, 255);
     print_hud_lut_string(HUD_LUT_GLOBAL, 112, 40, (*gPCToggleStringsPtr)[2]);
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
 
@@ -389,7 +401,7 @@ void puppycam_display_options() {
     }
     newcam_sinpos = sins(gGlobalTimer * 5000) * 4;
     gDPSetScissor(gDisplayListHead++, G_SC_NON_INTERLACE, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, 255);
+    set_text_env_color(255, 255, 255, 255);
     print_generic_string( 80 - newcam_sinpos, 132 - (32 * (gPCOptionSelected - gPCOptionScroll)),  (*gPCToggleStringsPtr)[3]);
     print_generic_string(232 + newcam_sinpos, 132 - (32 * (gPCOptionSelected - gPCOptionScroll)),  (*gPCToggleStringsPtr)[4]);
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
@@ -509,6 +521,8 @@ static void create_puppycam1_nodes(void) {
         vec3s_copy(sPuppyVolumeStack[gPuppyVolumeCount]->pos, pos);
         vec3s_copy(sPuppyVolumeStack[gPuppyVolumeCount]->radius, diff);
         sPuppyVolumeStack[gPuppyVolumeCount]->rot = 0; // Doesn't support rotation.
+        sPuppyVolumeStack[gPuppyVolumeCount]->sinRot = 0.0f;
+        sPuppyVolumeStack[gPuppyVolumeCount]->cosRot = 1.0f;
         sPuppyVolumeStack[gPuppyVolumeCount]->func = newcam_fixedcam[i].newcam_hard_script;
         tempAngle->yaw = PUPPY_NULL;
         tempAngle->pitch = PUPPY_NULL;
@@ -592,6 +606,7 @@ void puppycam_init(void) {
     gPuppyCam.debugFlags            = PUPPYDEBUG_LOCK_CONTROLS;
     puppycam_reset_values();
     create_puppycam1_nodes();
+    sPuppyVolumeGridArea = -1;
 }
 
 void puppycam_input_pitch(void) {
@@ -999,6 +1014,90 @@ const struct sPuppyAngles puppyAnglesNull = {
     PUPPY_NULL,
 };
 
+static s32 puppycam_get_volume_cell_coord(s32 coord) {
+    return GET_CELL_COORD(CLAMP(coord, -LEVEL_BOUNDARY_MAX, (LEVEL_BOUNDARY_MAX - 1)));
+}
+
+// Finds the range of cells a volume overlaps. Rotated boxes use the bounds of the rotated box.
+static void puppycam_get_volume_cell_range(struct sPuppyVolume *volume, s32 *minCellX, s32 *minCellZ, s32 *maxCellX, s32 *maxCellZ) {
+    s32 extentX, extentZ;
+
+    if (volume->shape == PUPPYVOLUME_SHAPE_CYLINDER) {
+        extentX = volume->radius[0];
+        extentZ = volume->radius[0];
+    } else {
+        extentX = (absf(volume->radius[0] * volume->cosRot) + absf(volume->radius[2] * volume->sinRot)) + 1;
+        extentZ = (absf(volume->radius[0] * volume->sinRot) + absf(volume->radius[2] * volume->cosRot)) + 1;
+    }
+
+    *minCellX = puppycam_get_volume_cell_coord(volume->pos[0] - extentX);
+    *maxCellX = puppycam_get_volume_cell_coord(volume->pos[0] + extentX);
+    *minCellZ = puppycam_get_volume_cell_coord(volume->pos[2] - extentZ);
+    *maxCellZ = puppycam_get_volume_cell_coord(volume->pos[2] + extentZ);
+}
+
+// Bins the current area's volumes into cells, so only the volumes in the target's cell need to be checked.
+// Volumes keep their stack order within each cell, so overlapping volumes are still applied in the same order.
+static void puppycam_build_volume_grid(void) {
+    struct sPuppyVolume *volume;
+    s32 minCellX, minCellZ, maxCellX, maxCellZ;
+    s32 i, x, z;
+    s32 numEntries = 0;
+
+    sPuppyVolumeGridArea  = gCurrAreaIndex;
+    sPuppyVolumeGridCount = gPuppyVolumeCount;
+    sPuppyVolumeGridValid = FALSE;
+    bzero(sPuppyVolumeCellStart, sizeof(sPuppyVolumeCellStart));
+
+    // First pass: count the volumes in each cell.
+    for (i = 0; i < gPuppyVolumeCount; i++) {
+        volume = sPuppyVolumeStack[i];
+        if (volume->area != gCurrAreaIndex) {
+            continue;
+        }
+
+        puppycam_get_volume_cell_range(volume, &minCellX, &minCellZ, &maxCellX, &maxCellZ);
+        numEntries += ((maxCellX - minCellX) + 1) * ((maxCellZ - minCellZ) + 1);
+        if (numEntries > PUPPYCAM_VOLUME_GRID_ENTRIES) {
+            append_puppyprint_log("Puppycamera volume grid full, checking all volumes.");
+            return;
+        }
+
+        for (z = minCellZ; z <= maxCellZ; z++) {
+            for (x = minCellX; x <= maxCellX; x++) {
+                sPuppyVolumeCellStart[(z * NUM_CELLS) + x + 1]++;
+            }
+        }
+    }
+
+    for (i = 0; i < (NUM_CELLS * NUM_CELLS); i++) {
+        sPuppyVolumeCellStart[i + 1] += sPuppyVolumeCellStart[i];
+    }
+
+    // Second pass: fill in the lists, using each cell's start as a cursor.
+    for (i = 0; i < gPuppyVolumeCount; i++) {
+        volume = sPuppyVolumeStack[i];
+        if (volume->area != gCurrAreaIndex) {
+            continue;
+        }
+
+        puppycam_get_volume_cell_range(volume, &minCellX, &minCellZ, &maxCellX, &maxCellZ);
+        for (z = minCellZ; z <= maxCellZ; z++) {
+            for (x = minCellX; x <= maxCellX; x++) {
+                sPuppyVolumeCellList[sPuppyVolumeCellStart[(z * NUM_CELLS) + x]++] = i;
+            }
+        }
+    }
+
+    // Each cursor now points at the start of the next cell, so shift them back.
+    for (i = (NUM_CELLS * NUM_CELLS); i > 0; i--) {
+        sPuppyVolumeCellStart[i] = sPuppyVolumeCellStart[i - 1];
+    }
+    sPuppyVolumeCellStart[0] = 0;
+
+    sPuppyVolumeGridValid = TRUE;
+}
+
 // Checks the bounding box of a puppycam volume. If it's inside, then set the pointer to the current index.
 static s32 puppycam_check_volume_bounds(struct sPuppyVolume *volume, s32 index) {
     s32 rel[3];
@@ -1007,12 +1106,13 @@ static s32 puppycam_check_volume_bounds(struct sPuppyVolume *volume, s32 index)
     if (sPuppyVolumeStack[index]->room != gMarioCurrentRoom && sPuppyVolumeStack[index]->room != -1) {
         return FALSE;
     }
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.puppycam_volume);
     if (sPuppyVolumeStack[index]->shape == PUPPYVOLUME_SHAPE_BOX) {
         // Fetch the relative position. to the triggeree.
         vec3_diff(rel, sPuppyVolumeStack[index]->pos, &gPuppyCam.targetObj->oPosVec);
         // Use the dark, forbidden arts of trig to rotate the volume.
-        pos[0] = rel[2] * sins(sPuppyVolumeStack[index]->rot) + rel[0] * coss(sPuppyVolumeStack[index]->rot);
-        pos[1] = rel[2] * coss(sPuppyVolumeStack[index]->rot) - rel[0] * sins(sPuppyVolumeStack[index]->rot);
+        pos[0] = rel[2] * sPuppyVolumeStack[index]->sinRot + rel[0] * sPuppyVolumeStack[index]->cosRot;
+        pos[1] = rel[2] * sPuppyVolumeStack[index]->cosRot - rel[0] * sPuppyVolumeStack[index]->sinRot;
 #ifdef VISUAL_DEBUG
         Vec3f debugPos[2];
         vec3f_set(debugPos[0], sPuppyVolumeStack[index]->pos[0],    sPuppyVolumeStack[index]->pos[1],    sPuppyVolumeStack[index]->pos[2]);
@@ -1292,13 +1392,28 @@ static void puppycam_projection(void) {
 // Calls any scripts to affect the camera, if applicable.
 static void puppycam_script(void) {
     u16 i = 0;
+    u16 first, last;
+    s32 index;
     struct sPuppyVolume volume;
 
     if (gPuppyVolumeCount == 0 || !gPuppyCam.targetObj) {
         return;
     }
-    for (i = 0; i < gPuppyVolumeCount; i++) {
-        if (puppycam_check_volume_bounds(&volume, i)) {
+    if (sPuppyVolumeGridArea != gCurrAreaIndex || sPuppyVolumeGridCount != gPuppyVolumeCount) {
+        puppycam_build_volume_grid();
+    }
+    if (sPuppyVolumeGridValid) {
+        s32 cell = (puppycam_get_volume_cell_coord(gPuppyCam.targetObj->oPosZ) * NUM_CELLS)
+                  + puppycam_get_volume_cell_coord(gPuppyCam.targetObj->oPosX);
+        first = sPuppyVolumeCellStart[cell];
+        last  = sPuppyVolumeCellStart[cell + 1];
+    } else {
+        first = 0;
+        last  = gPuppyVolumeCount;
+    }
+    for (i = first; i < last; i++) {
+        index = (sPuppyVolumeGridValid ? sPuppyVolumeCellList[i] : i);
+        if (puppycam_check_volume_bounds(&volume, index)) {
             // First applies pos and focus, for the most basic of volumes.
             if (volume.angles != NULL) {
                 if (volume.angles->pos[0]   != PUPPY_NULL) gPuppyCam.pos[0]   = volume.angles->pos[0];
@@ -139,6 +139,8 @@ struct sPuppyVolume
     u8 shape;
     u8 area;
     u8 fov;
+    f32 sinRot;                  // sins(rot), set when the volume is created.
+    f32 cosRot;                  // coss(rot), set when the volume is created.
 };
 
 enum gPuppyCamBeh
@@ -41,6 +41,7 @@ a modern game engine's developer's console.
 #include "engine/surface_load.h"
 #include "audio/data.h"
 #include "audio/external.h"
+#include "audio/governor.h"
 #include "audio/heap.h"
 #include "audio/load.h"
 #include "hud.h"
@@ -49,6 +50,8 @@ a modern game engine's developer's console.
 #include "buffers/buffers.h"
 #include "profiling.h"
 #include "segment_symbols.h"
+#include "behavior_profiler.h"
+#include "boot/tlsf.h"
 
 #ifdef PUPPYPRINT
 
@@ -230,6 +233,41 @@ void set_segment_memory_printout(u32 segment, u32 amount) {
     ramsizeSegment[segment + nameTable - 2] = amount;
 }
 
+/**
+ * Print the usage, high water mark and fragmentation of a memory pool on one line of the ram overview.
+ */
+static void print_memory_pool_stats(const char *name, struct MemoryPool *pool, s32 y, char *textBytes) {
+    struct TlsfStats stats;
+
+    if (pool == NULL || y - gPPSegScroll <= 0 || y - gPPSegScroll >= SCREEN_HEIGHT) {
+        return;
+    }
+
+    mem_pool_get_stats(pool, &stats);
+    u32 freeSpace = (stats.totalSpace - stats.usedSpace);
+    s32 fragmentation = (freeSpace != 0) ? (100 - ((stats.largestFree * 100) / freeSpace)) : 0;
+
+    sprintf(textBytes, "%s:", name);
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "0x%X/0x%X", stats.usedSpace, stats.totalSpace);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "Peak 0x%X Frag %d%%", stats.highWater, fragmentation);
+    print_small_text_light(SCREEN_WIDTH - 24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+}
+
+static void print_slab_pool_stats(const char *name, struct SlabPool *pool, s32 y, char *textBytes) {
+    if (pool == NULL || y - gPPSegScroll <= 0 || y - gPPSegScroll >= SCREEN_HEIGHT) {
+        return;
+    }
+
+    sprintf(textBytes, "%s:", name);
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "%d/%d", pool->numUsed, pool->numBlocks);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "Peak %d x 0x%X", pool->highWater, pool->blockSize);
+    print_small_text_light(SCREEN_WIDTH - 24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+}
+
 void print_ram_overview(void) {
     char textBytes[64];
     s32 y = 56;
@@ -281,6 +319,17 @@ void print_ram_overview(void) {
         }
         y += 12;
     }
+
+    y += 12;
+    print_memory_pool_stats("Effects Pool", gEffectsMemoryPool, y, textBytes);
+    y += 12;
+    print_memory_pool_stats("Object Pool", gObjectMemoryPool, y, textBytes);
+    y += 12;
+    print_slab_pool_stats("Object Sidecars", gObjectSidecarPool, y, textBytes);
+#ifdef PUPPYCAM
+    y += 12;
+    print_memory_pool_stats("Puppycam Pool", gPuppyMemoryPool, y, textBytes);
+#endif
 }
 
 static const char *audioPoolNames[NUM_AUDIO_POOLS] = {
@@ -387,6 +436,11 @@ static void print_audio_overview(void) {
     print_set_envcolour(255, 255, 255, 255);
     print_small_text_light(x, y, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
 
+#ifdef AUDIO_QUALITY_GOVERNOR
+    sprintf(textBytes, "QUALITY LEVEL: %d", audio_governor_get_level());
+    print_small_text_light((SCREEN_WIDTH - x), y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#endif
+
 #ifdef AUDIO_PROFILING
     for (s32 i = 0; i < ARRAY_COUNT(audioBenchmarkNames); i++) {
         y += 12;
@@ -486,6 +540,45 @@ void puppyprint_render_collision(void) {
 #endif
 }
 
+#ifdef BEHAVIOR_PROFILER
+/**
+ * Shows the behaviors that took the most time to update, averaged per frame.
+ * Behaviors are shown by the address of their script.
+ */
+void puppyprint_render_behaviors(void) {
+    char textBytes[32];
+    struct BehaviorProfile *profile;
+    s32 i;
+
+    prepare_blank_box();
+    render_blank_box(16, 36, 192, (36 + 12 + (BEHAVIOR_PROFILER_TOP_COUNT * 10)), 0x00, 0x00, 0x00, 0x80);
+    finish_blank_box();
+
+    print_small_text_light(24,  40, "Behavior", PRINT_TEXT_ALIGN_LEFT,  PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(144, 40, "Time",     PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(184, 40, "Calls",    PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+
+    for (i = 0; (profile = behavior_profiler_get_top(i)) != NULL; i++) {
+        s32 y = (52 + (i * 10));
+
+        if (profile->behavior != NULL) {
+            sprintf(textBytes, "%08X", (u32) profile->behavior);
+        } else {
+            sprintf(textBytes, "Other");
+        }
+        print_small_text_light(24, y, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+        sprintf(textBytes, "%d" PP_CYCLE_STRING, (s32) PP_CYCLE_CONV(profile->cycles));
+        print_small_text_light(144, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+        sprintf(textBytes, "%d", profile->calls);
+        print_small_text_light(184, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    }
+
+#ifdef UNF
+    print_small_text_light(160, (SCREEN_HEIGHT - 32), "Press A to send all behaviors over USB", PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
+#endif
+}
+#endif
+
 extern void print_fps(s32 x, s32 y);
 
 void print_basic_profiling(void) {
@@ -502,15 +595,16 @@ void print_basic_profiling(void) {
 }
 
 void puppyprint_render_standard(void) {
-    char textBytes[128];
+    char textBytes[160];
 
-    sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
+    sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d\n\nCamera Volumes: %d",
             gPuppyCallCounter.matrix,
             gPuppyCallCounter.collision_floor,
             gPuppyCallCounter.collision_wall,
             gPuppyCallCounter.collision_ceil,
             gPuppyCallCounter.collision_water,
-            gPuppyCallCounter.collision_raycast
+            gPuppyCallCounter.collision_raycast,
+            gPuppyCallCounter.puppycam_volume
     );
     print_small_text_light(SCREEN_WIDTH-16, 32, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
 }
@@ -1044,6 +1138,9 @@ struct PuppyPrintPage ppPages[] = {
 #ifdef BETTER_REVERB
     [PUPPYPRINT_PAGE_BETTER_REVERB] = {&better_reverb_preset_menu,      "Reverb Config"},
 #endif
+#ifdef BEHAVIOR_PROFILER
+    [PUPPYPRINT_PAGE_BEHAVIORS]     = {&puppyprint_render_behaviors,    "Behaviors"},
+#endif
 };
 
 #define MENU_BOX_WIDTH 128
@@ -1183,6 +1280,11 @@ void puppyprint_profiler_process(void) {
             if (viewCycle == 255)
                 viewCycle = 3;
         }
+#endif
+#ifdef BEHAVIOR_PROFILER
+        if (sPPDebugPage == PUPPYPRINT_PAGE_BEHAVIORS && (gPlayer1Controller->buttonPressed & A_BUTTON)) {
+            behavior_profiler_dump();
+        }
 #endif
         if (sPPDebugPage == PUPPYPRINT_PAGE_RAM) {
             if (gPlayer1Controller->buttonDown & U_JPAD && gPPSegScroll > 0)  {
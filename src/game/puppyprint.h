@@ -50,6 +50,7 @@ struct CallCounter {
     u16 collision_water;
     u16 collision_raycast;
     u16 matrix;
+    u16 puppycam_volume;
 };
 
 struct PuppyPrintPage{
@@ -101,6 +102,9 @@ enum PPPages {
 #ifdef BETTER_REVERB
     PUPPYPRINT_PAGE_BETTER_REVERB,
 #endif
+#ifdef BEHAVIOR_PROFILER
+    PUPPYPRINT_PAGE_BEHAVIORS,
+#endif
 };
 
 #ifdef PUPPYPRINT_DEBUG
@@ -18,6 +18,8 @@
 #include "string.h"
 #include "color_presets.h"
 #include "emutest.h"
+#include "room_visibility.h"
+#include "matrix_cache.h"
 
 #include "config.h"
 #include "config/config_world.h"
@@ -50,6 +52,12 @@
 s16 gMatStackIndex = 0;
 ALIGNED16 Mat4 gMatStack[32];
 ALIGNED16 Mtx *gMatStackFixed[32];
+#ifdef MATRIX_CACHE
+u32 gMatStackVersion[32];
+// The cache entry the next inc_mat_stack pushes, see get_cached_node_matrix.
+static struct MatrixCacheEntry *sPendingMatrixCacheEntry = NULL;
+static s32 sPendingMatrixCacheHit = FALSE;
+#endif
 f32 sAspectRatio;
 
 /**
@@ -348,6 +356,12 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
  * render modes of layers.
  */
 void geo_append_display_list(void *displayList, s32 layer) {
+#ifdef STREAM_LEVEL_SEGMENTS
+    // The RSP reads the display list through the segment table, so it has to be decompressed by now.
+    if (gStreamedSegmentsPending != 0) {
+        stream_require_segment((uintptr_t) displayList >> 24);
+    }
+#endif
 #ifdef F3DEX_GBI_2
     gSPLookAt(gDisplayListHead++, gCurLookAt);
 #endif
@@ -384,12 +398,65 @@ void geo_append_display_list(void *displayList, s32 layer) {
 }
 
 static void inc_mat_stack() {
+#ifdef MATRIX_CACHE
+    struct MatrixCacheEntry *entry = sPendingMatrixCacheEntry;
+
+    if (entry != NULL) {
+        sPendingMatrixCacheEntry = NULL;
+        gMatStackIndex++;
+        if (sPendingMatrixCacheHit) {
+            gMatStackFixed[gMatStackIndex] = &entry->mtx[entry->buffer];
+        } else {
+            gMatStackFixed[gMatStackIndex] = matrix_cache_store(entry, gMatStack[gMatStackIndex]);
+        }
+        gMatStackVersion[gMatStackIndex] = entry->version;
+        return;
+    }
+    gMatStackVersion[gMatStackIndex + 1] = MATRIX_CACHE_VERSION_NONE;
+#endif
     Mtx *mtx = alloc_display_list(sizeof(*mtx));
     gMatStackIndex++;
     mtxf_to_mtx(mtx, gMatStack[gMatStackIndex]);
     gMatStackFixed[gMatStackIndex] = mtx;
 }
 
+#ifdef MATRIX_CACHE
+/**
+ * Looks up a node's matrix in the matrix cache. If it's unchanged since the last frame, it's copied to
+ * gMatStack[gMatStackIndex + 1], TRUE is returned, and the next inc_mat_stack reuses its fixed point matrix.
+ * Otherwise, the matrix has to be computed as usual, and the next inc_mat_stack stores it in the cache.
+ */
+static s32 get_cached_node_matrix(struct GraphNode *node, void *object, u32 parentVersion, Vec3f params[MATRIX_CACHE_NUM_PARAMS]) {
+    s32 hit;
+
+    sPendingMatrixCacheEntry = matrix_cache_get(node, object, node->type, parentVersion, params, &hit);
+    sPendingMatrixCacheHit = hit;
+    if (hit) {
+        mtxf_copy(gMatStack[gMatStackIndex + 1], sPendingMatrixCacheEntry->mtxf);
+    }
+
+    return hit;
+}
+#endif
+
+/**
+ * Returns TRUE if the matrix of a node that transforms its parent's matrix is unchanged since
+ * the last frame, in which case it's already on gMatStack and doesn't need to be computed.
+ */
+static s32 get_cached_transform_matrix(UNUSED struct GraphNode *node, UNUSED Vec3f translation, UNUSED Vec3s rotation, UNUSED f32 scale) {
+#ifdef MATRIX_CACHE
+    Vec3f params[MATRIX_CACHE_NUM_PARAMS];
+
+    vec3f_copy(params[0], translation);
+    vec3s_to_vec3f(params[1], rotation);
+    vec3f_set(params[2], scale, scale, scale);
+
+    return get_cached_node_matrix(node, gCurGraphNodeObject, gMatStackVersion[gMatStackIndex], params);
+#else
+    return FALSE;
+#endif
+}
+
 static void append_dl_and_return(struct GraphNodeDisplayList *node) {
     if (node->displayList != NULL) {
         geo_append_display_list(node->displayList, GET_GRAPH_NODE_LAYER(node->node.flags));
@@ -555,6 +622,8 @@ void setup_global_light() {
     gSPSetLights1(gDisplayListHead++, (*curLight));
 }
 
+static void update_frustum_planes(void);
+
 /**
  * Process a camera node.
  */
@@ -570,6 +639,7 @@ void geo_process_camera(struct GraphNodeCamera *node) {
     gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(rollMtx), G_MTX_PROJECTION | G_MTX_MUL | G_MTX_NOPUSH);
 
     mtxf_lookat(gCameraTransform, node->pos, node->focus, node->roll);
+    update_frustum_planes();
 
     // Calculate the lookAt
 #ifdef F3DEX_GBI_2
@@ -624,7 +694,9 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
     Vec3f translation;
 
     vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!get_cached_transform_matrix(&node->node, translation, node->rotation, 1.0f)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
     inc_mat_stack();
     append_dl_and_return((struct GraphNodeDisplayList *)node);
@@ -639,7 +711,9 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
     Vec3f translation;
 
     vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!get_cached_transform_matrix(&node->node, translation, gVec3sZero, 1.0f)) {
+        mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
     inc_mat_stack();
     append_dl_and_return((struct GraphNodeDisplayList *)node);
@@ -651,7 +725,9 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_rotation(struct GraphNodeRotation *node) {
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!get_cached_transform_matrix(&node->node, gVec3fZero, node->rotation, 1.0f)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
     inc_mat_stack();
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
@@ -666,7 +742,9 @@ void geo_process_scale(struct GraphNodeScale *node) {
     Vec3f scaleVec;
 
     vec3f_set(scaleVec, node->scale, node->scale, node->scale);
-    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    if (!get_cached_transform_matrix(&node->node, gVec3fZero, gVec3sZero, node->scale)) {
+        mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    }
 
     inc_mat_stack();
     append_dl_and_return((struct GraphNodeDisplayList *)node);
@@ -817,7 +895,9 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
         rotation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
     }
 
-    mtxf_rotate_xyz_and_translate_and_mul(rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!get_cached_transform_matrix(&node->node, translation, rotation, 1.0f)) {
+        mtxf_rotate_xyz_and_translate_and_mul(rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
     inc_mat_stack();
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
@@ -928,22 +1008,16 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
 /**
  * Check whether an object is in view to determine whether if it should be drawn.
  * This is known as frustum culling.
- * It checks whether the object is far away, very close or behind the camera and 
- * vertically or horizontally out of view. 
- * The radius used is specified in DEFAULT_CULLING_RADIUS unless the object 
+ * It checks whether the object is far away, very close or behind the camera and
+ * vertically or horizontally out of view.
+ * The radius used is specified in DEFAULT_CULLING_RADIUS unless the object
  * has a culling radius node that specifies another value.
- * 
- * The matrix parameter should be the top of the matrix stack, which is the
- * object's transformation matrix times the camera 'look-at' matrix. The math
- * is counter-intuitive, but it checks column 3 (translation vector) of this
- * matrix to determine where the origin (0,0,0) in object space will be once
- * transformed to camera space (x+ = right, y+ = up, z = 'coming out the screen').
- * 
- * In 3D graphics, you typically model the world as being moved in front of a
- * static camera instead of a moving camera through a static world, which in
- * this case simplifies calculations. Note that the perspective matrix is not
- * on the matrix stack, so there are still calculations with the fov to compute
- * the slope of the lines of the frustum, these are done once during geo_process_perspective.
+ *
+ * Rather than transforming every object into camera space and comparing it against
+ * the slopes of the frustum, the planes of the frustum are moved into world space once
+ * per frame in geo_process_camera. An object's bounding sphere can then be tested
+ * directly against its world position, before its matrix is even built, so objects
+ * that are out of view skip that entirely.
  *
  *        z-
  *
@@ -955,59 +1029,152 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
  *       \|/
  *        C       x+
  *
- * Since (0,0,0) is unaffected by rotation, columns 0, 1 and 2 are ignored.
+ * The planes are first set up in camera space (x+ = right, y+ = up, z = 'coming out the screen'),
+ * using the slopes of the frustum computed during geo_process_perspective.
  */
 
 #define NO_CULLING_EMULATOR_WHITELIST (EMU_PROJECT64 | EMU_PARALLEL_LAUNCHER | EMU_MUPEN)
 
-s32 obj_is_in_view(struct GraphNodeObject *node) {
-    struct GraphNode *geo = node->sharedChild;
+// The near and far planes don't come from the projection. They keep objects from
+// being rendered far away, very close or behind the camera. This makes the HOLP not
+// update when the camera is far away, and it makes PU travel safe when the camera is
+// locked on the main map. If Mario were rendered with a depth over 65536 it would
+// cause overflow when converting the transformation matrix to a fixed point matrix.
+#define CULLING_NEAR_DEPTH   100.0f
+#define CULLING_FAR_DEPTH  20000.0f
+
+enum FrustumPlanes {
+    FRUSTUM_PLANE_NEAR,
+    FRUSTUM_PLANE_FAR,
+    FRUSTUM_PLANE_LEFT,
+    FRUSTUM_PLANE_RIGHT,
+#ifdef VERTICAL_CULLING
+    // Unlike with horizontal culling, there is no top plane, since objects
+    // above the screen can still have their shadows on screen.
+    FRUSTUM_PLANE_BOTTOM,
+#endif
+    FRUSTUM_PLANE_COUNT,
+};
 
-    s16 cullingRadius;
+/**
+ * A world space plane. Points with dot(normal, pos) + dist < 0 are outside of it.
+ */
+struct FrustumPlane {
+    Vec3f normal;
+    f32 dist;
+};
 
-    if (geo != NULL && geo->type == GRAPH_NODE_TYPE_CULLING_RADIUS) {
-        cullingRadius = ((struct GraphNodeCullingRadius *) geo)->cullingRadius;
-    } else {
-        cullingRadius = DEFAULT_CULLING_RADIUS;
-    }
+static struct FrustumPlane sFrustumPlanes[FRUSTUM_PLANE_COUNT];
+static s32 sNumFrustumPlanes = 0;
 
-    // Check whether the object is not too far away or too close / behind the camera.
-    // This makes the HOLP not update when the camera is far away, and it
-    // makes PU travel safe when the camera is locked on the main map.
-    // If Mario were rendered with a depth over 65536 it would cause overflow
-    // when converting the transformation matrix to a fixed point matrix.
-    f32 cameraToObjectDepth = node->cameraToObject[2];
-
-    #define VALID_DEPTH_MIDDLE (-20100.f / 2.f)
-    #define VALID_DEPTH_RANGE (19900 / 2.f)
-    if (absf(cameraToObjectDepth - VALID_DEPTH_MIDDLE) >= VALID_DEPTH_RANGE + cullingRadius) {
-        return FALSE;
+/**
+ * Set a frustum plane from a camera space plane, moving it into world space.
+ */
+static void set_frustum_plane(s32 index, f32 x, f32 y, f32 z, f32 dist) {
+    struct FrustumPlane *plane = &sFrustumPlanes[index];
+    f32 invMag = 1.0f / sqrtf(sqr(x) + sqr(y) + sqr(z));
+    s32 i;
+
+    // Normalize the plane so that distances to it can be compared with culling radii.
+    x *= invMag;
+    y *= invMag;
+    z *= invMag;
+
+    // The camera transform is a rotation and translation, so the world space normal is
+    // the camera space normal rotated back, and the translation moves the plane.
+    for (i = 0; i < 3; i++) {
+        plane->normal[i] = (gCameraTransform[i][0] * x) + (gCameraTransform[i][1] * y) + (gCameraTransform[i][2] * z);
     }
+    plane->dist = (dist * invMag) + (gCameraTransform[3][0] * x) + (gCameraTransform[3][1] * y) + (gCameraTransform[3][2] * z);
+}
+
+/**
+ * Set up the world space frustum planes from the current camera and perspective.
+ */
+static void update_frustum_planes(void) {
+    set_frustum_plane(FRUSTUM_PLANE_NEAR, 0.0f, 0.0f, -1.0f, -CULLING_NEAR_DEPTH);
+    set_frustum_plane(FRUSTUM_PLANE_FAR,  0.0f, 0.0f,  1.0f,  CULLING_FAR_DEPTH);
+    sNumFrustumPlanes = (FRUSTUM_PLANE_FAR + 1);
 
 #ifndef CULLING_ON_EMULATOR
     // If certain emulators are detected, skip any other culling.
-    if(gEmulator & NO_CULLING_EMULATOR_WHITELIST){
-        return TRUE;
+    if (gEmulator & NO_CULLING_EMULATOR_WHITELIST) {
+        return;
     }
 #endif
+    if (gCurGraphNodeCamFrustum == NULL) {
+        return;
+    }
 
+    f32 hSlope = gCurGraphNodeCamFrustum->halfFovHorizontal;
+
+    set_frustum_plane(FRUSTUM_PLANE_LEFT,   1.0f, 0.0f, -hSlope, 0.0f);
+    set_frustum_plane(FRUSTUM_PLANE_RIGHT, -1.0f, 0.0f, -hSlope, 0.0f);
 #ifdef VERTICAL_CULLING
-    f32 vScreenEdge = -cameraToObjectDepth * gCurGraphNodeCamFrustum->halfFovVertical;
+    set_frustum_plane(FRUSTUM_PLANE_BOTTOM, 0.0f, 1.0f, -gCurGraphNodeCamFrustum->halfFovVertical, 0.0f);
+#endif
+    sNumFrustumPlanes = FRUSTUM_PLANE_COUNT;
+}
 
-    // Unlike with horizontal culling, we only check if the object is bellow the screen
-    // to prevent shadows from being culled.
-    if (node->cameraToObject[1] < -vScreenEdge - cullingRadius) {
-        return FALSE;
+/**
+ * Returns whether a sphere at the given world space position is in view.
+ */
+static s32 is_sphere_in_view(Vec3f worldPos, f32 cullingRadius) {
+    struct FrustumPlane *plane = sFrustumPlanes;
+    s32 i;
+
+    for (i = 0; i < sNumFrustumPlanes; i++, plane++) {
+        if (vec3f_dot(plane->normal, worldPos) + plane->dist < -cullingRadius) {
+            return FALSE;
+        }
     }
+    return TRUE;
+}
 
-#endif
-    
-    f32 hScreenEdge = -cameraToObjectDepth * gCurGraphNodeCamFrustum->halfFovHorizontal;
+s32 obj_is_in_view(struct GraphNodeObject *node, Vec3f worldPos) {
+    struct GraphNode *geo = node->sharedChild;
 
-    if (absf(node->cameraToObject[0]) > hScreenEdge + cullingRadius) {
-        return FALSE;
+    s16 cullingRadius;
+
+    if (geo != NULL && geo->type == GRAPH_NODE_TYPE_CULLING_RADIUS) {
+        cullingRadius = ((struct GraphNodeCullingRadius *) geo)->cullingRadius;
+    } else {
+        cullingRadius = DEFAULT_CULLING_RADIUS;
+    }
+
+    return is_sphere_in_view(worldPos, cullingRadius);
+}
+
+/**
+ * Process a culling bounds node. Its children are only processed if the sphere
+ * around its bounding box is in view, using the same tests as objects.
+ * Assumes the current transformation isn't scaled.
+ */
+void geo_process_culling_bounds(struct GraphNodeCullingBounds *node) {
+    Vec3f center, halfSize, worldPos;
+
+    vec3f_set(center, ((node->min[0] + node->max[0]) * 0.5f),
+                      ((node->min[1] + node->max[1]) * 0.5f),
+                      ((node->min[2] + node->max[2]) * 0.5f));
+    vec3f_set(halfSize, ((node->max[0] - node->min[0]) * 0.5f),
+                        ((node->max[1] - node->min[1]) * 0.5f),
+                        ((node->max[2] - node->min[2]) * 0.5f));
+
+    linear_mtxf_mul_vec3f_and_translate(gMatStack[gMatStackIndex], worldPos, center);
+
+    if (node->node.children != NULL && is_sphere_in_view(worldPos, vec3_mag(halfSize))) {
+        geo_process_node_and_siblings(node->node.children);
+    }
+}
+
+/**
+ * Process a room node. Its children are only processed while its room
+ * is visible from the camera's room.
+ */
+void geo_process_room(struct GraphNodeRoom *node) {
+    if (node->node.children != NULL && room_is_visible(node->room)) {
+        geo_process_node_and_siblings(node->node.children);
     }
-    return TRUE;
 }
 
 #ifdef VISUAL_DEBUG
@@ -1040,6 +1207,25 @@ void visualise_object_hitbox(struct Object *node) {
 }
 #endif
 
+/**
+ * Returns TRUE if an object's matrix is unchanged since the last frame,
+ * in which case it's already on gMatStack and doesn't need to be computed.
+ */
+static s32 get_cached_object_matrix(UNUSED struct Object *node) {
+#ifdef MATRIX_CACHE
+    Vec3f params[MATRIX_CACHE_NUM_PARAMS];
+
+    vec3f_copy(params[0], node->header.gfx.pos);
+    vec3s_to_vec3f(params[1], node->header.gfx.angle);
+    vec3f_copy(params[2], node->header.gfx.scale);
+
+    // An object's matrix doesn't depend on its parent's matrix.
+    return get_cached_node_matrix(&node->header.gfx.node, NULL, MATRIX_CACHE_VERSION_ROOT, params);
+#else
+    return FALSE;
+#endif
+}
+
 /**
  * Process an object node.
  */
@@ -1049,35 +1235,38 @@ void geo_process_object(struct Object *node) {
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
         // Maintain throw matrix pointer if the game is paused as it won't be updated.
         Mat4 *oldThrowMatrix = (sCurrPlayMode == PLAY_MODE_PAUSED) ? node->header.gfx.throwMatrix : NULL;
+        Vec3f worldPos;
+
+        // Find where the object's origin ends up, without building its matrix.
+        // This is needed for sound even if the object isn't drawn.
+        if (!noThrowMatrix) {
+            vec3f_copy(worldPos, (*node->header.gfx.throwMatrix)[3]);
+        } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
+            linear_mtxf_mul_vec3f_and_translate(gMatStack[gMatStackIndex], worldPos, node->header.gfx.pos);
+        } else {
+            vec3f_copy(worldPos, node->header.gfx.pos);
+        }
+        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, worldPos);
 
-        // If the throw matrix is null and the object is invisible, there is no need
-        // to update billboarding, scale, rotation, etc. 
-        // This still updates translation since it is needed for sound.
-        if (isInvisible && noThrowMatrix) {
-            mtxf_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos);
+        // FIXME: correct types
+        if (node->header.gfx.animInfo.curAnim != NULL) {
+            geo_set_animation_globals(&node->header.gfx.animInfo, (node->header.gfx.node.flags & GRAPH_RENDER_HAS_ANIMATION) != 0);
         }
-        else{
+
+        // Objects that are invisible, out of view or in a room that can't be seen into
+        // don't need their billboarding, scale, rotation, etc. to be computed at all.
+        if (!isInvisible && obj_is_in_visible_room(node) && obj_is_in_view(&node->header.gfx, worldPos)) {
             if (!noThrowMatrix) {
                 mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], *node->header.gfx.throwMatrix, node->header.gfx.scale);
             } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
                 mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex],
                             node->header.gfx.pos, node->header.gfx.scale, gCurGraphNodeCamera->roll);
-            } else {
+            } else if (!get_cached_object_matrix(node)) {
                 mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
                 mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
             }
-        }
-
-        node->header.gfx.throwMatrix = &gMatStack[++gMatStackIndex];
-        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, (*node->header.gfx.throwMatrix)[3]);
-
-        // FIXME: correct types
-        if (node->header.gfx.animInfo.curAnim != NULL) {
-            geo_set_animation_globals(&node->header.gfx.animInfo, (node->header.gfx.node.flags & GRAPH_RENDER_HAS_ANIMATION) != 0);
-        }
 
-        if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
-            gMatStackIndex--;
+            node->header.gfx.throwMatrix = &gMatStack[gMatStackIndex + 1];
             inc_mat_stack();
 
             if (node->header.gfx.sharedChild != NULL) {
@@ -1093,9 +1282,10 @@ void geo_process_object(struct Object *node) {
             if (node->header.gfx.node.children != NULL) {
                 geo_process_node_and_siblings(node->header.gfx.node.children);
             }
+
+            gMatStackIndex--;
         }
 
-        gMatStackIndex--;
         gCurrAnimType = ANIM_TYPE_NONE;
         node->header.gfx.throwMatrix = oldThrowMatrix;
     }
@@ -1210,6 +1400,8 @@ static GeoProcessFunc GeoProcessJumpTable[] = {
     [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = (GeoProcessFunc) geo_try_process_children,
     [GRAPH_NODE_TYPE_ROOT                ] = (GeoProcessFunc) geo_try_process_children,
     [GRAPH_NODE_TYPE_START               ] = (GeoProcessFunc) geo_try_process_children,
+    [GRAPH_NODE_TYPE_CULLING_BOUNDS      ] = (GeoProcessFunc) geo_process_culling_bounds,
+    [GRAPH_NODE_TYPE_ROOM                ] = (GeoProcessFunc) geo_process_room,
 };
 
 /**
@@ -1277,6 +1469,9 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
         mtxf_identity(gMatStack[gMatStackIndex]);
         mtxf_to_mtx(initialMatrix, gMatStack[gMatStackIndex]);
         gMatStackFixed[gMatStackIndex] = initialMatrix;
+#ifdef MATRIX_CACHE
+        gMatStackVersion[gMatStackIndex] = MATRIX_CACHE_VERSION_ROOT;
+#endif
         gSPViewport(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(viewport));
         gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(gMatStackFixed[gMatStackIndex]),
                   G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH);
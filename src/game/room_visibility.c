@@ -0,0 +1,165 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "area.h"
+#include "camera.h"
+#include "debug.h"
+#include "engine/surface_collision.h"
+#include "object_fields.h"
+#include "object_list_processor.h"
+#include "rendering_graph_node.h"
+#include "room_visibility.h"
+
+/**
+ * Room based visibility.
+ *
+ * Each frame, the rooms the camera and Mario are in are visible, along with every room that can be seen
+ * into from them through a portal. Level geometry wrapped in GEO_ROOM nodes is only drawn while its room
+ * is visible, and neither are objects in a room (see obj_is_in_visible_room).
+ * Objects with OBJ_FLAG_THROTTLE_IN_UNSEEN_ROOM also only update every few frames while their room isn't visible.
+ *
+ * Portals come from two places:
+ *  - Doors, which already record the rooms on either side of their transition room in gDoorAdjacentRooms.
+ *  - Portals declared with GEO_ROOM_PORTAL in the area's geo layout, or room_visibility_add_portal(s),
+ *    for openings without a door. Room numbers are only unique within an area, so each portal stores
+ *    the area it belongs to. These are cleared whenever objects are cleared on level load.
+ *
+ * Room 0 is the "global" room (object surfaces, or surfaces without room data),
+ * so when the camera is in it, every room is treated as visible.
+ */
+
+static struct RoomPortal sRoomPortals[ROOM_VISIBILITY_MAX_PORTALS];
+static s32 sNumRoomPortals = 0;
+static s8 sRoomPortalLoadingArea = ROOM_PORTAL_NO_AREA;
+
+static u32 sVisibleRooms[ROOM_VISIBILITY_MAX_ROOMS / 32];
+static u8 sAllRoomsVisible = TRUE;
+static u16 sRoomVisibilityUpdateFrame = 0;
+
+void room_visibility_reset(void) {
+    sNumRoomPortals = 0;
+    sAllRoomsVisible = TRUE;
+}
+
+/**
+ * Set the area that GEO_ROOM_PORTAL commands add portals to, while its geo layout is processed.
+ */
+void room_visibility_set_loading_area(s32 areaIndex) {
+    sRoomPortalLoadingArea = areaIndex;
+}
+
+void room_visibility_add_portal(s32 areaIndex, RoomData roomA, RoomData roomB) {
+    if (areaIndex == ROOM_PORTAL_LOADING_AREA) {
+        assert(sRoomPortalLoadingArea != ROOM_PORTAL_NO_AREA, "GEO_ROOM_PORTAL used outside of an area geo layout!");
+        areaIndex = sRoomPortalLoadingArea;
+    }
+
+    if (areaIndex >= 0 && sNumRoomPortals < ROOM_VISIBILITY_MAX_PORTALS) {
+        sRoomPortals[sNumRoomPortals].areaIndex = areaIndex;
+        sRoomPortals[sNumRoomPortals].roomA = roomA;
+        sRoomPortals[sNumRoomPortals].roomB = roomB;
+        sNumRoomPortals++;
+    }
+}
+
+void room_visibility_add_portals(const struct RoomPortal *portals, s32 count) {
+    s32 i;
+
+    for (i = 0; i < count; i++) {
+        room_visibility_add_portal(portals[i].areaIndex, portals[i].roomA, portals[i].roomB);
+    }
+}
+
+static void set_room_visible(RoomData room) {
+    if (room > 0 && room < ROOM_VISIBILITY_MAX_ROOMS) {
+        sVisibleRooms[room / 32] |= (1 << (room % 32));
+    }
+}
+
+/**
+ * Marks a room visible, along with every room that can be seen into from it.
+ */
+static void set_rooms_visible_from(RoomData room) {
+    s32 i;
+
+    set_room_visible(room);
+
+    for (i = 0; i < sNumRoomPortals; i++) {
+        if (sRoomPortals[i].areaIndex != gCurrAreaIndex) {
+            continue;
+        }
+
+        if (sRoomPortals[i].roomA == room) {
+            set_room_visible(sRoomPortals[i].roomB);
+        } else if (sRoomPortals[i].roomB == room) {
+            set_room_visible(sRoomPortals[i].roomA);
+        }
+    }
+
+    // Doors: a transition room is visible from either side, and both sides are visible from it.
+    for (i = 0; i < ARRAY_COUNT(gDoorAdjacentRooms); i++) {
+        struct TransitionRoomData *transitionRoom = &gDoorAdjacentRooms[i];
+
+        if (i == room) {
+            set_room_visible(transitionRoom->forwardRoom);
+            set_room_visible(transitionRoom->backwardRoom);
+        } else if (transitionRoom->forwardRoom == room || transitionRoom->backwardRoom == room) {
+            set_room_visible(i);
+        }
+    }
+}
+
+/**
+ * Finds the rooms visible from the camera's room. Only needs to be called once per frame,
+ * room_is_visible calls it when the visible rooms are out of date.
+ */
+void room_visibility_update(void) {
+    RoomData cameraRoom;
+
+    sRoomVisibilityUpdateFrame = gAreaUpdateCounter;
+    bzero(sVisibleRooms, sizeof(sVisibleRooms));
+
+    if (gCurrentArea == NULL || gCurrentArea->surfaceRooms == NULL) {
+        sAllRoomsVisible = TRUE;
+        return;
+    }
+
+    cameraRoom = get_room_at_pos(gLakituState.pos[0], gLakituState.pos[1], gLakituState.pos[2]);
+    if (cameraRoom <= 0) {
+        // The camera can be outside of the level geometry, so fall back to Mario's room.
+        cameraRoom = gMarioCurrentRoom;
+    }
+
+    sAllRoomsVisible = (cameraRoom <= 0 || cameraRoom >= ROOM_VISIBILITY_MAX_ROOMS);
+    if (sAllRoomsVisible) {
+        return;
+    }
+
+    set_rooms_visible_from(cameraRoom);
+
+    // The camera can clip into a neighbouring room while Mario is still in his own,
+    // which should never hide what's around Mario.
+    if (gMarioCurrentRoom != cameraRoom && gMarioCurrentRoom > 0 && gMarioCurrentRoom < ROOM_VISIBILITY_MAX_ROOMS) {
+        set_rooms_visible_from(gMarioCurrentRoom);
+    }
+}
+
+s32 room_is_visible(RoomData room) {
+    if (sRoomVisibilityUpdateFrame != gAreaUpdateCounter) {
+        room_visibility_update();
+    }
+
+    if (sAllRoomsVisible || room <= 0 || room >= ROOM_VISIBILITY_MAX_ROOMS) {
+        return TRUE;
+    }
+
+    return ((sVisibleRooms[room / 32] & (1 << (room % 32))) != 0);
+}
+
+/**
+ * Returns whether an object is in a room that's currently visible.
+ * Objects that aren't in a room (oRoom of -1, or the global room 0) are always visible.
+ */
+s32 obj_is_in_visible_room(struct Object *obj) {
+    return room_is_visible(obj->oRoom);
+}
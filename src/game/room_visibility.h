@@ -0,0 +1,45 @@
+#ifndef ROOM_VISIBILITY_H
+#define ROOM_VISIBILITY_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * The number of rooms the visibility system can track. Rooms are positive RoomData values.
+ */
+#define ROOM_VISIBILITY_MAX_ROOMS 128
+
+/**
+ * The maximum number of portals a level can declare with room_visibility_add_portal.
+ */
+#define ROOM_VISIBILITY_MAX_PORTALS 64
+
+/**
+ * Pass as the area index to add a portal to the area whose geo layout is currently being processed.
+ */
+#define ROOM_PORTAL_LOADING_AREA -1
+
+/**
+ * The loading area while no area's geo layout is being processed.
+ */
+#define ROOM_PORTAL_NO_AREA -2
+
+/**
+ * A pair of rooms in an area that can be seen into from each other.
+ */
+struct RoomPortal {
+    /*0x00*/ s8 areaIndex;
+    /*0x01*/ RoomData roomA;
+    /*0x02*/ RoomData roomB;
+}; /*0x03*/
+
+void room_visibility_reset(void);
+void room_visibility_set_loading_area(s32 areaIndex);
+void room_visibility_add_portal(s32 areaIndex, RoomData roomA, RoomData roomB);
+void room_visibility_add_portals(const struct RoomPortal *portals, s32 count);
+void room_visibility_update(void);
+s32 room_is_visible(RoomData room);
+s32 obj_is_in_visible_room(struct Object *obj);
+
+#endif // ROOM_VISIBILITY_H
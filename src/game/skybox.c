@@ -180,6 +180,41 @@ static s32 get_top_left_tile_idx(s8 player) {
     return tileRow * SKYBOX_COLS + tileCol;
 }
 
+/**
+ * The number of tiles drawn in the grid.
+ */
+#define SKYBOX_GRID_SIZE (3 * SKYBOX_SIZE)
+#define SKYBOX_NUM_GRID_TILES (SKYBOX_GRID_SIZE * SKYBOX_GRID_SIZE)
+
+/**
+ * The skybox's display list doesn't change unless the camera rotates, so it's kept across frames
+ * instead of being rebuilt every frame.
+ *
+ * Each player has two copies. A changed skybox is always written to the copy that wasn't drawn
+ * last frame, so the RSP never reads a display list or vertex that's being rewritten.
+ *
+ * Tile vertices only depend on the tile, so each copy keeps a tile's vertices in a slot determined by
+ * the tile's row and column in the tilemap. When the grid scrolls, only the tiles that scrolled into
+ * view get new vertices.
+ */
+struct SkyboxCache {
+    /// The texture list, color, and ortho bounds this copy was built with
+    const Texture *const *textures;
+    s32 upperLeftTile;
+    f32 orthoBounds[4];
+    s8 colorIndex;
+    u8 valid;
+
+    /// The tile index + color whose vertices are in each slot, or -1 if the slot is empty
+    s32 slotTiles[SKYBOX_NUM_GRID_TILES];
+    Vtx slotVerts[SKYBOX_NUM_GRID_TILES][4];
+    Mtx ortho;
+    Gfx dlist[5 + SKYBOX_NUM_GRID_TILES * 7];
+};
+
+static struct SkyboxCache sSkyboxCache[2][2];
+static u8 sSkyboxCacheIndex[2];
+
 /**
  * Generates vertices for the skybox tile.
  *
@@ -187,57 +222,78 @@ static s32 get_top_left_tile_idx(s8 player) {
  *                  into an x and y by modulus and division by SKYBOX_COLS. x and y are then scaled by
  *                  SKYBOX_TILE_WIDTH to get a point in world space.
  */
-Vtx *make_skybox_rect(s32 tileIndex, s8 colorIndex) {
-    Vtx *verts = alloc_display_list(4 * sizeof(*verts));
+static void make_skybox_rect(Vtx *verts, s32 tileIndex, s8 colorIndex) {
     s16 x = tileIndex % SKYBOX_COLS * SKYBOX_TILE_WIDTH;
     s16 y = SKYBOX_HEIGHT - tileIndex / SKYBOX_COLS * SKYBOX_TILE_HEIGHT;
 
-    if (verts != NULL) {
-        make_vertex(verts, 0, x, y, -1, 0, 0, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
-                    sSkyboxColors[colorIndex][2], 255);
-        make_vertex(verts, 1, x, y - SKYBOX_TILE_HEIGHT, -1, 0, 31 << 5, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
-                    sSkyboxColors[colorIndex][2], 255);
-        make_vertex(verts, 2, x + SKYBOX_TILE_WIDTH, y - SKYBOX_TILE_HEIGHT, -1, 31 << 5, 31 << 5, sSkyboxColors[colorIndex][0],
-                    sSkyboxColors[colorIndex][1], sSkyboxColors[colorIndex][2], 255);
-        make_vertex(verts, 3, x + SKYBOX_TILE_WIDTH, y, -1, 31 << 5, 0, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
-                    sSkyboxColors[colorIndex][2], 255);
-    }
-    return verts;
+    make_vertex(verts, 0, x, y, -1, 0, 0, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
+                sSkyboxColors[colorIndex][2], 255);
+    make_vertex(verts, 1, x, y - SKYBOX_TILE_HEIGHT, -1, 0, 31 << 5, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
+                sSkyboxColors[colorIndex][2], 255);
+    make_vertex(verts, 2, x + SKYBOX_TILE_WIDTH, y - SKYBOX_TILE_HEIGHT, -1, 31 << 5, 31 << 5, sSkyboxColors[colorIndex][0],
+                sSkyboxColors[colorIndex][1], sSkyboxColors[colorIndex][2], 255);
+    make_vertex(verts, 3, x + SKYBOX_TILE_WIDTH, y, -1, 31 << 5, 0, sSkyboxColors[colorIndex][0], sSkyboxColors[colorIndex][1],
+                sSkyboxColors[colorIndex][2], 255);
 }
 
 /**
  * Draws a 3x3 grid of 32x32 sections of the original skybox image.
  * The row and column are converted into an index into the skybox's tile list, which is then drawn in
  * world space so that the tiles will rotate with the camera.
+ *
+ * Tiles are drawn sorted by texture, so tiles that share a texture only load it into TMEM once.
  */
-void draw_skybox_tile_grid(Gfx **dlist, s8 background, s8 player, s8 colorIndex) {
-    s32 row;
-    s32 col;
-
-    for (row = 0; row < (3 * SKYBOX_SIZE); row++) {
-        for (col = 0; col < (3 * SKYBOX_SIZE); col++) {
+static void draw_skybox_tile_grid(Gfx **dlist, struct SkyboxCache *cache, s8 player) {
+    const Texture *textures[SKYBOX_NUM_GRID_TILES];
+    Vtx *vertices[SKYBOX_NUM_GRID_TILES];
+    const Texture *loadedTexture = NULL;
+    s32 tileRow = sSkyBoxInfo[player].upperLeftTile / SKYBOX_COLS;
+    s32 tileCol = sSkyBoxInfo[player].upperLeftTile % SKYBOX_COLS;
+    s32 numTiles = 0;
+    s32 row, col, i, j;
+
+    for (row = 0; row < SKYBOX_GRID_SIZE; row++) {
+        for (col = 0; col < SKYBOX_GRID_SIZE; col++) {
             s32 tileIndex = sSkyBoxInfo[player].upperLeftTile + row * SKYBOX_COLS + col;
             if (tileIndex >= SKYBOX_ROWS * SKYBOX_COLS) {
                 continue;
             }
 
-            const Texture *const texture =
-                (*(SkyboxTexture *) segmented_to_virtual(sSkyboxTextures[background]))[tileIndex];
-            Vtx *vertices = make_skybox_rect(tileIndex, colorIndex);
+            // The slot only depends on the tile's position in the tilemap, so it stays the same while the tile is in view.
+            s32 slot = ((tileRow + row) % SKYBOX_GRID_SIZE) * SKYBOX_GRID_SIZE + ((tileCol + col) % SKYBOX_GRID_SIZE);
+            s32 slotTile = (tileIndex << 1) | cache->colorIndex;
+            if (cache->slotTiles[slot] != slotTile) {
+                cache->slotTiles[slot] = slotTile;
+                make_skybox_rect(cache->slotVerts[slot], tileIndex, cache->colorIndex);
+            }
 
-            gLoadBlockTexture((*dlist)++, 32, 32, G_IM_FMT_RGBA, texture);
-            gSPVertex((*dlist)++, VIRTUAL_TO_PHYSICAL(vertices), 4, 0);
-            gSPDisplayList((*dlist)++, dl_draw_quad_verts_0123);
+            // Insertion sort by texture, keeping the original order for tiles that share one.
+            const Texture *texture = cache->textures[tileIndex];
+            for (i = numTiles; i > 0 && (uintptr_t) textures[i - 1] > (uintptr_t) texture; i--) {
+                textures[i] = textures[i - 1];
+                vertices[i] = vertices[i - 1];
+            }
+            textures[i] = texture;
+            vertices[i] = cache->slotVerts[slot];
+            numTiles++;
+        }
+    }
+
+    for (j = 0; j < numTiles; j++) {
+        if (textures[j] != loadedTexture) {
+            loadedTexture = textures[j];
+            gLoadBlockTexture((*dlist)++, 32, 32, G_IM_FMT_RGBA, loadedTexture);
         }
+        gSPVertex((*dlist)++, VIRTUAL_TO_PHYSICAL(vertices[j]), 4, 0);
+        gSPDisplayList((*dlist)++, dl_draw_quad_verts_0123);
     }
 }
 
-void *create_skybox_ortho_matrix(s8 player) {
+static void get_skybox_ortho_bounds(s8 player, f32 bounds[4]) {
     f32 left = sSkyBoxInfo[player].scaledX;
     f32 right = sSkyBoxInfo[player].scaledX + SCREEN_WIDTH;
     f32 bottom = sSkyBoxInfo[player].scaledY - SCREEN_HEIGHT;
     f32 top = sSkyBoxInfo[player].scaledY;
-    Mtx *mtx = alloc_display_list(sizeof(*mtx));
 
 #ifdef WIDESCREEN
     f32 half_width = (4.0f / 3.0f) / GFX_DIMENSIONS_ASPECT_RATIO * SCREEN_CENTER_X;
@@ -249,34 +305,58 @@ void *create_skybox_ortho_matrix(s8 player) {
     }
 #endif
 
-    if (mtx != NULL) {
-        guOrtho(mtx, left, right, bottom, top, 0.0f, 3.0f, 1.0f);
-    }
-
-    return mtx;
+    bounds[0] = left;
+    bounds[1] = right;
+    bounds[2] = bottom;
+    bounds[3] = top;
 }
 
 /**
- * Creates the skybox's display list, then draws the 3x3 grid of tiles.
+ * Returns the skybox's display list, rebuilding it if the camera's orientation changed since it was last built.
  */
-Gfx *init_skybox_display_list(s8 player, s8 background, s8 colorIndex) {
-    s32 dlCommandCount = 5 + (3 * 3) * 7; // 5 for the start and end, plus 9 skybox tiles
-    void *skybox = alloc_display_list(dlCommandCount * sizeof(Gfx) * sqr(SKYBOX_SIZE));
-    Gfx *dlist = skybox;
-
-    if (skybox == NULL) {
-        return NULL;
-    } else {
-        Mtx *ortho = create_skybox_ortho_matrix(player);
-
-        gSPDisplayList(dlist++, dl_skybox_begin);
-        gSPMatrix(dlist++, VIRTUAL_TO_PHYSICAL(ortho), G_MTX_PROJECTION | G_MTX_MUL | G_MTX_NOPUSH);
-        gSPDisplayList(dlist++, dl_skybox_tile_tex_settings);
-        draw_skybox_tile_grid(&dlist, background, player, colorIndex);
-        gSPDisplayList(dlist++, dl_skybox_end);
-        gSPEndDisplayList(dlist);
+static Gfx *init_skybox_display_list(s8 player, s8 background, s8 colorIndex) {
+    struct SkyboxCache *cache = &sSkyboxCache[player][sSkyboxCacheIndex[player]];
+    const Texture *const *textures = *(SkyboxTexture *) segmented_to_virtual(sSkyboxTextures[background]);
+    f32 orthoBounds[4];
+    s32 i;
+
+    get_skybox_ortho_bounds(player, orthoBounds);
+
+    if (cache->valid && cache->textures == textures && cache->colorIndex == colorIndex
+        && cache->upperLeftTile == sSkyBoxInfo[player].upperLeftTile
+        && cache->orthoBounds[0] == orthoBounds[0] && cache->orthoBounds[1] == orthoBounds[1]
+        && cache->orthoBounds[2] == orthoBounds[2] && cache->orthoBounds[3] == orthoBounds[3]) {
+        return cache->dlist;
+    }
+
+    // Something changed, so build the skybox in the copy that wasn't drawn last frame.
+    sSkyboxCacheIndex[player] ^= 1;
+    cache = &sSkyboxCache[player][sSkyboxCacheIndex[player]];
+
+    if (!cache->valid || cache->textures != textures) {
+        for (i = 0; i < SKYBOX_NUM_GRID_TILES; i++) {
+            cache->slotTiles[i] = -1;
+        }
+    }
+    cache->textures = textures;
+    cache->colorIndex = colorIndex;
+    cache->upperLeftTile = sSkyBoxInfo[player].upperLeftTile;
+    for (i = 0; i < 4; i++) {
+        cache->orthoBounds[i] = orthoBounds[i];
     }
-    return skybox;
+    cache->valid = TRUE;
+
+    guOrtho(&cache->ortho, orthoBounds[0], orthoBounds[1], orthoBounds[2], orthoBounds[3], 0.0f, 3.0f, 1.0f);
+
+    Gfx *dlist = cache->dlist;
+    gSPDisplayList(dlist++, dl_skybox_begin);
+    gSPMatrix(dlist++, VIRTUAL_TO_PHYSICAL(&cache->ortho), G_MTX_PROJECTION | G_MTX_MUL | G_MTX_NOPUSH);
+    gSPDisplayList(dlist++, dl_skybox_tile_tex_settings);
+    draw_skybox_tile_grid(&dlist, cache, player);
+    gSPDisplayList(dlist++, dl_skybox_end);
+    gSPEndDisplayList(dlist);
+
+    return cache->dlist;
 }
 
 /**
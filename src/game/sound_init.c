@@ -2,6 +2,7 @@
 
 #include "area.h"
 #include "audio/external.h"
+#include "audio/governor.h"
 #include "audio/load.h"
 #include "audio/synthesis.h"
 #include "engine/graph_node.h"
@@ -18,6 +19,7 @@
 #include "rumble_init.h"
 #include "puppyprint.h"
 #include "profiling.h"
+#include "event_trace.h"
 
 #include "config/config_audio.h"
 
@@ -373,12 +375,15 @@ void thread4_sound(UNUSED void *arg) {
 
         osRecvMesg(&sSoundMesgQueue, &msg, OS_MESG_BLOCK);
         profiler_audio_started(); // also starts PROFILER_TIME_SUB_AUDIO_UPDATE inside
+        TRACE_BEGIN(TRACE_EVENT_AUDIO_UPDATE, 0);
         if (gResetTimer < 25) {
             struct SPTask *spTask = create_next_audio_frame_task();
             if (spTask != NULL) {
                 dispatch_audio_sptask(spTask);
             }
         }
+        TRACE_END(TRACE_EVENT_AUDIO_UPDATE, 0);
         profiler_audio_completed(); // also completes PROFILER_TIME_SUB_AUDIO_UPDATE inside
+        audio_governor_update();
     }
 }
@@ -95,6 +95,9 @@ void unload_object(struct Object *obj) {
     obj->prevObj = NULL;
     obj->oFloor = NULL;
 
+    // Objects that unload without freeing their sidecar would otherwise leak it until the level ends.
+    obj_free_sidecar(obj);
+
     obj->header.gfx.throwMatrix = NULL;
     stop_sounds_from_source(obj->header.gfx.cameraToObject);
     geo_remove_child(&obj->header.gfx.node);
@@ -158,7 +161,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     }
 #endif
 
-    obj->unused1 = 0;
+    obj->sidecar = NULL;
     obj->bhvStackIndex = 0;
     obj->bhvDelayTimer = 0;
 
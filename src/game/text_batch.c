@@ -0,0 +1,234 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "game_init.h"
+#include "memory.h"
+#include "print.h"
+#include "segment2.h"
+#include "text_batch.h"
+
+/**
+ * Shared glyph batcher for the dialog font and HUD text.
+ *
+ * Text used to be drawn one character at a time, loading the glyph's texture into TMEM before
+ * every single character. Instead, glyphs are queued up between text_batch_begin and
+ * text_batch_end, then sorted by env color and texture so each distinct glyph is only loaded
+ * once per batch, followed by every quad or rectangle that uses it.
+ *
+ * Glyphs that inherit the env color are always drawn first, followed by explicitly colored
+ * glyphs. Within those, glyphs are drawn in layer order.
+ *
+ * The env color the caller set up is saved when the batch begins, so inherited glyphs can still
+ * be drawn with it after an early flush has switched to an explicit color.
+ */
+
+/**
+ * The number of character quads sent to the RSP per vertex load (4 vertices each).
+ * Fast3D's vertex cache only holds 16 vertices, and its gSPVertex can't encode more.
+ */
+#ifdef F3D_NEW
+#define TEXT_BATCH_QUADS_PER_VTX_LOAD 4
+#else
+#define TEXT_BATCH_QUADS_PER_VTX_LOAD 8
+#endif
+
+struct TextBatchGlyph {
+    /*0x00*/ const Texture *texture;
+    /*0x04*/ u32 color;
+    /*0x08*/ s16 x;
+    /*0x0A*/ s16 y;
+    /*0x0C*/ u8 layer;
+    /*0x0D*/ u8 inherit;
+}; /*0x10*/
+
+static struct TextBatchGlyph sTextBatch[TEXT_BATCH_SIZE];
+static s32 sTextBatchCount = 0;
+static u8 sTextBatchType = TEXT_BATCH_NONE;
+static u32 sTextBatchEnvColor = 0; // The env color the caller set before the batch began.
+static u8 sTextBatchEnvColorChanged = FALSE; // Whether a flush has replaced the caller's env color.
+
+/**
+ * Start a batch. envColor is the env color the caller has set, which inherited glyphs are drawn with.
+ */
+void text_batch_begin(u8 type, u32 envColor) {
+    sTextBatchType = type;
+    sTextBatchCount = 0;
+    sTextBatchEnvColor = envColor;
+    sTextBatchEnvColorChanged = FALSE;
+}
+
+/**
+ * Returns whether glyph a should be drawn after glyph b.
+ */
+static s32 text_batch_glyph_after(struct TextBatchGlyph *a, struct TextBatchGlyph *b) {
+    if (a->inherit != b->inherit) {
+        return (a->inherit < b->inherit);
+    }
+    if (a->layer != b->layer) {
+        return (a->layer > b->layer);
+    }
+    if (a->color != b->color) {
+        return (a->color > b->color);
+    }
+    return ((uintptr_t) a->texture > (uintptr_t) b->texture);
+}
+
+/**
+ * Stable insertion sort, so glyphs with the same key keep their original order.
+ */
+static void text_batch_sort(void) {
+    s32 i, j;
+    struct TextBatchGlyph temp;
+
+    for (i = 1; i < sTextBatchCount; i++) {
+        temp = sTextBatch[i];
+        for (j = i - 1; j >= 0 && text_batch_glyph_after(&sTextBatch[j], &temp); j--) {
+            sTextBatch[j + 1] = sTextBatch[j];
+        }
+        sTextBatch[j + 1] = temp;
+    }
+}
+
+static void text_batch_set_env_color(u32 color) {
+    gDPSetEnvColor(gDisplayListHead++, (color >> 24), ((color >> 16) & 0xFF), ((color >> 8) & 0xFF), (color & 0xFF));
+}
+
+/**
+ * Returns the color a glyph is drawn with, and sets the env color when it differs from the last one.
+ * Inherited glyphs only need the caller's env color put back if an earlier flush replaced it.
+ */
+static u32 text_batch_glyph_color(struct TextBatchGlyph *glyph, u32 color, s32 first) {
+    if (glyph->inherit) {
+        if (first && sTextBatchEnvColorChanged) {
+            text_batch_set_env_color(sTextBatchEnvColor);
+            sTextBatchEnvColorChanged = FALSE;
+        }
+        return sTextBatchEnvColor;
+    }
+
+    if (first || glyph->color != color) {
+        text_batch_set_env_color(glyph->color);
+        sTextBatchEnvColorChanged = TRUE;
+    }
+    return glyph->color;
+}
+
+/**
+ * Draw the dialog font glyphs as quads, using vertex_ia8_char as the template for each quad.
+ */
+static void text_batch_flush_ia_quads(void) {
+    Vtx *quadVerts = segmented_to_virtual(vertex_ia8_char);
+    Vtx *verts = alloc_display_list(sTextBatchCount * 4 * sizeof(Vtx));
+    u32 color = sTextBatchEnvColor;
+    s32 i, j, k;
+
+    if (verts == NULL) {
+        return;
+    }
+
+    for (i = 0; i < sTextBatchCount; i++) {
+        for (k = 0; k < 4; k++) {
+            verts[(i * 4) + k] = quadVerts[k];
+            verts[(i * 4) + k].v.ob[0] += sTextBatch[i].x;
+            verts[(i * 4) + k].v.ob[1] += sTextBatch[i].y;
+        }
+    }
+
+    for (i = 0; i < sTextBatchCount; i = j) {
+        const Texture *texture = sTextBatch[i].texture;
+        u8 inherit = sTextBatch[i].inherit;
+
+        color = text_batch_glyph_color(&sTextBatch[i], color, (i == 0 || inherit != sTextBatch[i - 1].inherit));
+
+        gDPPipeSync(gDisplayListHead++);
+        gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_IA, G_IM_SIZ_16b, 1, VIRTUAL_TO_PHYSICAL(texture));
+        gSPDisplayList(gDisplayListHead++, dl_ia_text_tex_load);
+
+        // Find the end of the run of glyphs sharing this texture.
+        for (j = i; j < sTextBatchCount && sTextBatch[j].texture == texture && sTextBatch[j].inherit == inherit
+                    && (inherit || sTextBatch[j].color == color); j++);
+
+        for (s32 first = i; first < j; first += TEXT_BATCH_QUADS_PER_VTX_LOAD) {
+            s32 numQuads = MIN(j - first, TEXT_BATCH_QUADS_PER_VTX_LOAD);
+
+            gSPVertex(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(verts + (first * 4)), (numQuads * 4), 0);
+            for (k = 0; k < numQuads; k++) {
+                gSP2Triangles(gDisplayListHead++, (k * 4) + 0, (k * 4) + 1, (k * 4) + 2, 0x0,
+                                                  (k * 4) + 0, (k * 4) + 2, (k * 4) + 3, 0x0);
+            }
+        }
+    }
+}
+
+/**
+ * Draw 16x16 HUD glyphs as texture rectangles. x and y are the top left corner in screen space.
+ */
+static void text_batch_flush_hud_rects(void) {
+    const Texture *texture = NULL;
+    u32 color = sTextBatchEnvColor;
+    s32 i;
+
+    for (i = 0; i < sTextBatchCount; i++) {
+        struct TextBatchGlyph *glyph = &sTextBatch[i];
+
+        color = text_batch_glyph_color(glyph, color, (i == 0 || glyph->inherit != sTextBatch[i - 1].inherit));
+
+        if (glyph->texture != texture) {
+            texture = glyph->texture;
+            gDPPipeSync(gDisplayListHead++);
+            gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, texture);
+            gSPDisplayList(gDisplayListHead++, dl_hud_img_load_tex_block);
+        }
+
+        gSPTextureRectangle(gDisplayListHead++, glyph->x << 2, glyph->y << 2, (glyph->x + 15) << 2,
+                            (glyph->y + 15) << 2, G_TX_RENDERTILE, 0, 0, 4 << 10, 1 << 10);
+    }
+}
+
+static void text_batch_flush(void) {
+    if (sTextBatchCount == 0) {
+        return;
+    }
+
+    text_batch_sort();
+
+    switch (sTextBatchType) {
+        case TEXT_BATCH_IA_QUADS:  text_batch_flush_ia_quads();  break;
+        case TEXT_BATCH_HUD_RECTS: text_batch_flush_hud_rects(); break;
+    }
+
+    sTextBatchCount = 0;
+}
+
+/**
+ * Queue a glyph. If inherit is set, the glyph is drawn with the env color the caller set before
+ * the batch began and color is ignored. If the batch is full, everything queued so far is drawn first.
+ */
+void text_batch_add(const Texture *texture, s16 x, s16 y, u8 layer, u8 inherit, u32 color) {
+    if (sTextBatchCount >= TEXT_BATCH_SIZE) {
+        text_batch_flush();
+    }
+
+    struct TextBatchGlyph *glyph = &sTextBatch[sTextBatchCount++];
+
+    glyph->texture = texture;
+    glyph->color   = (inherit ? 0 : color);
+    glyph->x       = x;
+    glyph->y       = y;
+    glyph->layer   = layer;
+    glyph->inherit = inherit;
+}
+
+/**
+ * Draw everything in the batch. The env color is left as the caller set it.
+ */
+void text_batch_end(void) {
+    text_batch_flush();
+
+    if (sTextBatchEnvColorChanged) {
+        text_batch_set_env_color(sTextBatchEnvColor);
+        sTextBatchEnvColorChanged = FALSE;
+    }
+
+    sTextBatchType = TEXT_BATCH_NONE;
+}
@@ -0,0 +1,38 @@
+#ifndef TEXT_BATCH_H
+#define TEXT_BATCH_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * The maximum number of glyphs that can be queued before the batch is flushed early.
+ */
+#define TEXT_BATCH_SIZE 128
+
+enum TextBatchTypes {
+    TEXT_BATCH_NONE,
+    TEXT_BATCH_IA_QUADS, // Dialog font glyphs, drawn as quads relative to the current modelview matrix.
+    TEXT_BATCH_HUD_RECTS, // 16x16 RGBA16 HUD glyphs, drawn as texture rectangles.
+};
+
+/**
+ * Glyphs are drawn in layer order first, so glyphs that are meant to overlap
+ * others (like accent marks) can be put on a higher layer.
+ */
+enum TextBatchLayers {
+    TEXT_BATCH_LAYER_BASE,
+    TEXT_BATCH_LAYER_OVERLAY,
+};
+
+/**
+ * Glyphs added with inherit set use whatever env color was set before the batch began.
+ * Any other glyph's color is set with gDPSetEnvColor before drawing it.
+ */
+#define TEXT_BATCH_COLOR(r, g, b, a) (((u32)(r) << 24) | ((u32)(g) << 16) | ((u32)(b) << 8) | (u32)(a))
+
+void text_batch_begin(u8 type, u32 envColor);
+void text_batch_add(const Texture *texture, s16 x, s16 y, u8 layer, u8 inherit, u32 color);
+void text_batch_end(void);
+
+#endif // TEXT_BATCH_H
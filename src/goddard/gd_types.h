@@ -221,7 +221,9 @@ struct ObjJoint {
     /* 0x1FC */ s32 attachFlags;                 //d_attach_to arg 0; "AttFlag"
     /* 0x200 */ struct GdVec3f attachOffset;
     /* 0x20C */ struct GdObj *attachedToObj;  // object that this object is attached to
-    /* 0x210 */ u8  filler5[24];
+    /* 0x210 */ struct SkinInfluence *influences; // flattened copy of weightGrp, built by reset_joint_weights
+    /* 0x214 */ s32 numInfluences;
+    /* 0x218 */ u8  filler5[16];
     /* 0x228 */ f32 unk228;
 }; /* sizeof = 0x22C */
 
@@ -347,7 +349,8 @@ struct ObjNet {
     /* 0x200 */ struct GdVec3f unk200;
     /* 0x20C */ struct ObjGroup *unk20C;
     /* 0x210 */ s32 ctrlType;     // has no purpose
-    /* 0x214 */ u8  filler2[8];
+    /* 0x214 */ struct SkinBaseVtx *skinBaseVtxs; // flattened copy of shapePtr->scaledVtxGroup
+    /* 0x218 */ s32 numSkinBaseVtxs;
     /* 0x21C */ struct ObjGroup *unk21C;
 }; /* sizeof = 0x220 */
 
@@ -450,6 +453,24 @@ struct ObjWeight {
     /* 0x3C */ struct ObjVertex* vtx;
 }; /* sizeof = 0x40 */
 
+/**
+ * A positive `ObjWeight`, flattened into an array so that skinning doesn't have to walk
+ * the weight group every frame. The joint-local offset is stored premultiplied by the weight.
+ */
+struct SkinInfluence {
+    /* 0x00 */ struct ObjVertex *vtx;
+    /* 0x04 */ struct GdVec3f offset; // vec20 * weightVal
+    /* 0x10 */ f32 weight;
+}; /* sizeof = 0x14 */
+
+/**
+ * The unweighted part of a skin vertex's position, which never changes after the weights are set up.
+ */
+struct SkinBaseVtx {
+    /* 0x00 */ struct ObjVertex *vtx;
+    /* 0x04 */ struct GdVec3f pos; // initPos * scaleFactor
+}; /* sizeof = 0x10 */
+
 /* This union is used in ObjGadget for a variable typed field.
 ** The type can be found by checking group unk4C */
 union ObjVarVal {
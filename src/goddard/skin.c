@@ -297,6 +297,19 @@ void func_80192CCC(struct ObjNet *net) {
     }
 }
 
+/**
+ * The skinned vertices of the head mostly sit still between frames (e.g. while idle), so the
+ * converters below only touch the display list vertices whose converted values actually changed.
+ */
+static s32 vtx_pos_matches(Vtx *vtx, s16 x, s16 y, s16 z) {
+    return vtx->v.ob[0] == x && vtx->v.ob[1] == y && vtx->v.ob[2] == z;
+}
+
+static s32 vtx_n_matches(Vtx *vtx, s16 x, s16 y, s16 z, u8 nx, u8 ny, u8 nz) {
+    return vtx->n.ob[0] == x && vtx->n.ob[1] == y && vtx->n.ob[2] == z
+        && (u8) vtx->n.n[0] == nx && (u8) vtx->n.n[1] == ny && (u8) vtx->n.n[2] == nz;
+}
+
 /* 241768 -> 241AB4; orig name: func_80192F98 */
 void convert_gd_verts_to_Vn(struct ObjGroup *grp) {
     UNUSED u8 filler1[20];
@@ -325,6 +338,11 @@ void convert_gd_verts_to_Vn(struct ObjGroup *grp) {
         ny = (u8)(vtx->normal.y * 255.0f);
         nz = (u8)(vtx->normal.z * 255.0f);
 
+        // Every linked Vtx gets the same data, so if the first one is unchanged they all are.
+        if (vtx->gbiVerts != NULL && vtx_n_matches(vtx->gbiVerts->data, x, y, z, nx, ny, nz)) {
+            continue;
+        }
+
         for (vtxlink = vtx->gbiVerts; vtxlink != NULL; vtxlink = vtxlink->prev) {
 #ifndef GBI_FLOATS
             vnPos = vtxlink->data->n.ob;
@@ -366,6 +384,10 @@ void convert_gd_verts_to_Vtx(struct ObjGroup *grp) {
         y = (s16) vtx->pos.y;
         z = (s16) vtx->pos.z;
 
+        if (vtx->gbiVerts != NULL && vtx_pos_matches(vtx->gbiVerts->data, x, y, z)) {
+            continue;
+        }
+
         for (vtxlink = vtx->gbiVerts; vtxlink != NULL; vtxlink = vtxlink->prev) {
 #ifndef GBI_FLOATS
             vtxcoords = vtxlink->data->v.ob;
@@ -477,6 +499,7 @@ void func_8019373C(struct ObjNet *net) {
                         addto_group(net->shapePtr->scaledVtxGroup, &vtx->header);
                     }
                 }
+                build_skin_base_verts(net);
             }
             break;
     }
@@ -6,6 +6,7 @@
 #include "joints.h"
 #include "macros.h"
 #include "objects.h"
+#include "renderer.h"
 #include "skin.h"
 #include "skin_movement.h"
 
@@ -64,15 +65,97 @@ void scale_verts(struct ObjGroup *a0) {
     }
 }
 
+/**
+ * Flattens the skin net's scaled vertex group into `net->skinBaseVtxs`, so `move_skin` can
+ * reset the vertices from a fixed-stride array instead of recomputing `initPos * scaleFactor`.
+ * Must be called after the joint weights have been reset, since that changes `scaleFactor`.
+ */
+void build_skin_base_verts(struct ObjNet *net) {
+    register struct ListNode *link;
+    struct ObjVertex *vtx;
+    struct SkinBaseVtx *base;
+    f32 scaleFactor;
+    s32 count = 0;
+
+    if (net->shapePtr == NULL || net->shapePtr->scaledVtxGroup == NULL) {
+        return;
+    }
+
+    for (link = net->shapePtr->scaledVtxGroup->firstMember; link != NULL; link = link->next) {
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // The vertex group doesn't change after the dynlist is loaded, so a rebuild can reuse the array.
+    if (net->skinBaseVtxs == NULL || net->numSkinBaseVtxs != count) {
+        net->skinBaseVtxs = gd_malloc_perm(count * sizeof(struct SkinBaseVtx));
+        if (net->skinBaseVtxs == NULL) {
+            net->numSkinBaseVtxs = 0;
+            return;
+        }
+    }
+    net->numSkinBaseVtxs = count;
+
+    base = net->skinBaseVtxs;
+    for (link = net->shapePtr->scaledVtxGroup->firstMember; link != NULL; link = link->next) {
+        vtx = (struct ObjVertex *) link->obj;
+        scaleFactor = vtx->scaleFactor;
+
+        base->vtx = vtx;
+        if (scaleFactor != 0.0f) {
+            base->pos.x = vtx->initPos.x * scaleFactor;
+            base->pos.y = vtx->initPos.y * scaleFactor;
+            base->pos.z = vtx->initPos.z * scaleFactor;
+        } else {
+            base->pos.x = base->pos.y = base->pos.z = 0.0f;
+        }
+        base++;
+    }
+}
+
 /* @ 23000C for 0x58; orig name: func8018183C*/
 void move_skin(struct ObjNet *net) {
-    UNUSED u8 filler[8];
+    register struct SkinBaseVtx *base;
+    register struct SkinBaseVtx *end;
 
-    if (net->shapePtr != NULL) {
+    if (net->skinBaseVtxs != NULL) {
+        end = net->skinBaseVtxs + net->numSkinBaseVtxs;
+        for (base = net->skinBaseVtxs; base < end; base++) {
+            base->vtx->pos = base->pos;
+        }
+    } else if (net->shapePtr != NULL) {
         scale_verts(net->shapePtr->scaledVtxGroup);
     }
 }
 
+/**
+ * Adds each of the joint's weighted offsets, transformed by the joint's matrix, to the vertices it
+ * influences. Since the offsets are premultiplied by the weight, the translation row is scaled by
+ * the weight instead of the transformed offset.
+ */
+static void apply_joint_influences(struct ObjJoint *joint) {
+    register struct SkinInfluence *inf;
+    register struct SkinInfluence *end;
+    register struct ObjVertex *vtx;
+    register f32 x, y, z, w;
+    Mat4f *mtx = &joint->matE8;
+
+    end = joint->influences + joint->numInfluences;
+    for (inf = joint->influences; inf < end; inf++) {
+        x = inf->offset.x;
+        y = inf->offset.y;
+        z = inf->offset.z;
+        w = inf->weight;
+        vtx = inf->vtx;
+
+        vtx->pos.x += (*mtx)[0][0] * x + (*mtx)[1][0] * y + (*mtx)[2][0] * z + (*mtx)[3][0] * w;
+        vtx->pos.y += (*mtx)[0][1] * x + (*mtx)[1][1] * y + (*mtx)[2][1] * z + (*mtx)[3][1] * w;
+        vtx->pos.z += (*mtx)[0][2] * x + (*mtx)[1][2] * y + (*mtx)[2][2] * z + (*mtx)[3][2] * w;
+    }
+}
+
 /* @ 230064 for 0x13C*/
 void func_80181894(struct ObjJoint *joint) {
     register struct ObjGroup *weightGroup; // baseGroup? weights Only?
@@ -83,6 +166,11 @@ void func_80181894(struct ObjJoint *joint) {
     register f32 scaleFactor;
     struct GdObj *linkedObj;
 
+    if (joint->influences != NULL) {
+        apply_joint_influences(joint);
+        return;
+    }
+
     weightGroup = joint->weightGrp;
     if (weightGroup != NULL) {
         for (link = weightGroup->firstMember; link != NULL; link = link->next) {
@@ -146,6 +234,49 @@ void reset_weight(struct ObjWeight *weight) {
     }
 }
 
+/**
+ * Flattens the joint's positive weights into `joint->influences`. The weight group's
+ * vertices and offsets are only set by `reset_weight`, so this only needs to happen then.
+ */
+static void build_joint_influences(struct ObjJoint *joint) {
+    register struct ListNode *link;
+    struct ObjWeight *weight;
+    struct SkinInfluence *inf;
+    s32 count = 0;
+
+    for (link = joint->weightGrp->firstMember; link != NULL; link = link->next) {
+        weight = (struct ObjWeight *) link->obj;
+        if (weight->weightVal > 0.0f && weight->vtx != NULL) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    if (joint->influences == NULL || joint->numInfluences != count) {
+        joint->influences = gd_malloc_perm(count * sizeof(struct SkinInfluence));
+        if (joint->influences == NULL) {
+            joint->numInfluences = 0;
+            return;
+        }
+    }
+    joint->numInfluences = count;
+
+    inf = joint->influences;
+    for (link = joint->weightGrp->firstMember; link != NULL; link = link->next) {
+        weight = (struct ObjWeight *) link->obj;
+        if (weight->weightVal > 0.0f && weight->vtx != NULL) {
+            inf->vtx = weight->vtx;
+            inf->offset.x = weight->vec20.x * weight->weightVal;
+            inf->offset.y = weight->vec20.y * weight->weightVal;
+            inf->offset.z = weight->vec20.z * weight->weightVal;
+            inf->weight = weight->weightVal;
+            inf++;
+        }
+    }
+}
+
 void reset_joint_weights(struct ObjJoint *joint) {
     struct ObjGroup *group;
 
@@ -153,5 +284,6 @@ void reset_joint_weights(struct ObjJoint *joint) {
     D_801B9EE8 = joint;
     if ((group = joint->weightGrp) != NULL) {
         apply_to_obj_types_in_group(OBJ_TYPE_WEIGHTS, (applyproc_t) reset_weight, group);
+        build_joint_influences(joint);
     }
 }
@@ -4,6 +4,7 @@
 #include "gd_types.h"
 
 void scale_verts(struct ObjGroup *a0);
+void build_skin_base_verts(struct ObjNet *net);
 void move_skin(struct ObjNet *net);
 void func_80181894(struct ObjJoint *joint);
 void reset_joint_weights(struct ObjJoint *joint);
@@ -1268,7 +1268,7 @@ void print_menu_cursor(void) {
  */
 void print_hud_lut_string_fade(s8 hudLUT, s16 x, s16 y, const unsigned char *text) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha - sTextFadeAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha - sTextFadeAlpha);
     print_hud_lut_string(hudLUT, x, y, text);
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
 }
@@ -1278,7 +1278,7 @@ void print_hud_lut_string_fade(s8 hudLUT, s16 x, s16 y, const unsigned char *tex
  */
 void print_generic_string_fade(s16 x, s16 y, const unsigned char *text) {
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha - sTextFadeAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha - sTextFadeAlpha);
     print_generic_string(x, y, text);
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
 }
@@ -1349,7 +1349,7 @@ void print_save_file_star_count(s8 fileIndex, s16 x, s16 y) {
 void print_main_menu_strings(void) {
     // Print "SELECT FILE" text
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_hud_lut_string(HUD_LUT_DIFF, SELECT_FILE_X, 35, textSelectFile);
     // Print file star counts
     print_save_file_star_count(SAVE_FILE_A, SAVEFILE_X1, 78);
@@ -1359,7 +1359,7 @@ void print_main_menu_strings(void) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
     // Print menu names
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_generic_string(SCORE_X, 39, textScore);
     print_generic_string(COPY_X, 39, textCopy);
     print_generic_string(ERASE_X, 39, textErase);
@@ -1368,7 +1368,7 @@ void print_main_menu_strings(void) {
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
     // Print file names
     gSPDisplayList(gDisplayListHead++, dl_menu_ia8_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_menu_generic_string(MARIOTEXT_X1, 65, textMarioA);
     print_menu_generic_string(MARIOTEXT_X2, 65, textMarioB);
     print_menu_generic_string(MARIOTEXT_X1, 105, textMarioC);
@@ -1422,7 +1422,7 @@ void print_score_menu_strings(void) {
 
     // Print file star counts
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_save_file_star_count(SAVE_FILE_A, 90, 76);
     print_save_file_star_count(SAVE_FILE_B, 211, 76);
     print_save_file_star_count(SAVE_FILE_C, 90, 119);
@@ -1431,7 +1431,7 @@ void print_score_menu_strings(void) {
 
     // Print menu names
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_generic_string(RETURN_X, 35, LANGUAGE_ARRAY(textReturn));
     print_generic_string(COPYFILE_X1, 35, LANGUAGE_ARRAY(textCopyFileButton));
     print_generic_string(ERASEFILE_X1, 35, LANGUAGE_ARRAY(textEraseFileButton));
@@ -1439,7 +1439,7 @@ void print_score_menu_strings(void) {
 
     // Print file names
     gSPDisplayList(gDisplayListHead++, dl_menu_ia8_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_menu_generic_string(89, 62, textMarioA);
     print_menu_generic_string(211, 62, textMarioB);
     print_menu_generic_string(89, 105, textMarioC);
@@ -1541,7 +1541,7 @@ void print_copy_menu_strings(void) {
     copy_menu_display_message(sStatusMessageID);
     // Print file star counts
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_save_file_star_count(SAVE_FILE_A, 90, 76);
     print_save_file_star_count(SAVE_FILE_B, 211, 76);
     print_save_file_star_count(SAVE_FILE_C, 90, 119);
@@ -1549,14 +1549,14 @@ void print_copy_menu_strings(void) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
     // Print menu names
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_generic_string(RETURN_X, 35, LANGUAGE_ARRAY(textReturn));
     print_generic_string(VIEWSCORE_X1, 35, LANGUAGE_ARRAY(textViewScore));
     print_generic_string(ERASEFILE_X2, 35, LANGUAGE_ARRAY(textEraseFileButton));
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
     // Print file names
     gSPDisplayList(gDisplayListHead++, dl_menu_ia8_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_menu_generic_string(89, 62, textMarioA);
     print_menu_generic_string(211, 62, textMarioB);
     print_menu_generic_string(89, 105, textMarioC);
@@ -1634,9 +1634,9 @@ void print_erase_menu_prompt(s16 x, s16 y) {
 
     // Print "YES NO" strings
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, sYesNoColor[0], sYesNoColor[0], sYesNoColor[0], sTextBaseAlpha);
+    set_text_env_color(sYesNoColor[0], sYesNoColor[0], sYesNoColor[0], sTextBaseAlpha);
     print_generic_string(x + 56, y, LANGUAGE_ARRAY(textYes));
-    gDPSetEnvColor(gDisplayListHead++, sYesNoColor[1], sYesNoColor[1], sYesNoColor[1], sTextBaseAlpha);
+    set_text_env_color(sYesNoColor[1], sYesNoColor[1], sYesNoColor[1], sTextBaseAlpha);
     print_generic_string(x + 98, y, LANGUAGE_ARRAY(textNo));
     gSPDisplayList(gDisplayListHead++, dl_ia_text_end);
 }
@@ -1740,7 +1740,7 @@ void print_erase_menu_strings(void) {
 
     // Print file star counts
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_save_file_star_count(SAVE_FILE_A, 90, 76);
     print_save_file_star_count(SAVE_FILE_B, 211, 76);
     print_save_file_star_count(SAVE_FILE_C, 90, 119);
@@ -1749,7 +1749,7 @@ void print_erase_menu_strings(void) {
 
     // Print menu names
     gSPDisplayList(gDisplayListHead++, dl_ia_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
 
     print_generic_string(RETURN_X, 35, textReturn);
     print_generic_string(VIEWSCORE_X2, 35, textViewScore);
@@ -1758,7 +1758,7 @@ void print_erase_menu_strings(void) {
 
     // Print file names
     gSPDisplayList(gDisplayListHead++, dl_menu_ia8_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_menu_generic_string(89, 62, textMarioA);
     print_menu_generic_string(211, 62, textMarioB);
     print_menu_generic_string(89, 105, textMarioC);
@@ -1785,7 +1785,7 @@ void print_sound_mode_menu_strings(void) {
 
     // Print "SOUND SELECT" text
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
 
     print_hud_lut_string(HUD_LUT_DIFF, SOUND_HUD_X, 32, LANGUAGE_ARRAY(textSoundSelect));
 #if MULTILANG
@@ -1803,9 +1803,9 @@ void print_sound_mode_menu_strings(void) {
     for (mode = 0, textX = 111; mode < ARRAY_COUNT(textSoundModes); textX += 99, mode++) {
 #endif
         if (mode == sSoundMode) {
-            gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+            set_text_env_color(255, 255, 255, sTextBaseAlpha);
         } else {
-            gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, sTextBaseAlpha);
+            set_text_env_color(0, 0, 0, sTextBaseAlpha);
         }
         print_generic_string(
             get_str_x_pos_from_center(textX, LANGUAGE_ARRAY(textSoundModes[mode]), 10.0f),
@@ -1816,16 +1816,16 @@ void print_sound_mode_menu_strings(void) {
     // In EU, print language mode names
     for (mode = 0, textX = 90; mode < 3; textX += 70, mode++) {
         if (mode == LANGUAGE_FUNCTION) {
-            gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+            set_text_env_color(255, 255, 255, sTextBaseAlpha);
         } else {
-            gDPSetEnvColor(gDisplayListHead++, 0, 0, 0, sTextBaseAlpha);
+            set_text_env_color(0, 0, 0, sTextBaseAlpha);
         }
         print_generic_string(
             get_str_x_pos_from_center(textX, textLanguage[mode], 10.0f),
             72, textLanguage[mode]);
     }
 
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_generic_string(182, 29, LANGUAGE_ARRAY(textReturn));
 #endif
 
@@ -1937,7 +1937,7 @@ void print_save_file_scores(s8 fileIndex) {
 
     // Print file name at top
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
     print_hud_lut_string(HUD_LUT_DIFF, MARIO_X, 15, textMario);
     print_hud_lut_string(HUD_LUT_GLOBAL, FILE_LETTER_X, 15, textFileLetter);
 
@@ -1946,7 +1946,7 @@ void print_save_file_scores(s8 fileIndex) {
     gSPDisplayList(gDisplayListHead++, dl_rgba16_text_end);
     // Print course scores
     gSPDisplayList(gDisplayListHead++, dl_menu_ia8_text_begin);
-    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, sTextBaseAlpha);
+    set_text_env_color(255, 255, 255, sTextBaseAlpha);
 
     for ((i = 0); (i < COURSE_STAGES_MAX); (i++)) {
         print_menu_generic_string((LEVEL_NAME_X + ((i < 9) * LEVEL_NUM_PAD)), (23 + (12 * (i + 1))), segmented_to_virtual(levelNameTable[i]));
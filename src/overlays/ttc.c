@@ -0,0 +1,28 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "audio/external.h"
+#include "behavior_data.h"
+#include "engine/math_util.h"
+#include "engine/surface_load.h"
+#include "game/memory.h"
+#include "game/obj_behaviors_2.h"
+#include "game/object_helpers.h"
+#include "game/object_list_processor.h"
+#include "game/spawn_sound.h"
+#include "levels/ttc/header.h"
+
+/**
+ * Behaviors only used in Tick Tock Clock. With BEHAVIOR_OVERLAYS, this file is linked into its own segment
+ * that the TTC level script loads, instead of into the engine.
+ */
+
+#include "game/behaviors/ttc_rotating_solid.inc.c"
+#include "game/behaviors/ttc_pendulum.inc.c"
+#include "game/behaviors/ttc_treadmill.inc.c" // TODO
+#include "game/behaviors/ttc_moving_bar.inc.c"
+#include "game/behaviors/ttc_cog.inc.c"
+#include "game/behaviors/ttc_pit_block.inc.c"
+#include "game/behaviors/ttc_elevator.inc.c"
+#include "game/behaviors/ttc_2d_rotator.inc.c"
+#include "game/behaviors/ttc_spinner.inc.c"
@@ -0,0 +1,540 @@
+#!/usr/bin/env python3
+"""
+Static display list analyzer.
+
+Reads the linked segment ELFs (build/<version>/actors/*.elf and build/<version>/levels/*/leveldata.elf),
+finds every Gfx array in them and simulates the F3DEX2 family vertex cache (F3DEX2, F3DZEX) and the RDP
+state each one sets, then reports per display list:
+
+  cmds        commands, including the final gsSPEndDisplayList
+  tris        triangles drawn
+  vtx         vertex loads / vertices loaded
+  unused      loaded vertices that no triangle used before they were replaced
+  merge       vertex loads that could have been merged into the previous one
+              (both fit in the vertex cache together, and only triangles were drawn in between)
+  tex         texture and TLUT loads / loads of data that was already in the same place in TMEM
+  pipesync    gsDPPipeSyncs / pipe syncs with no primitive drawn since the last one
+  tilesync    gsDPTileSyncs / tile syncs with no primitive drawn since the last one
+  modes       render state changes (other mode, combiner, geometry mode, colors) / ones that set the
+              state to what it already was
+
+Called display lists are treated as drawing something and leaving the state unknown, so only waste
+that is visible within a single display list is reported.
+
+With --rewrite, the given model.inc.c files are scanned for the same redundancies at the source level,
+and a diff is printed with them removed (or the files are edited in place with --write). The source
+pass is deliberately conservative: it only removes a gsDPPipeSync with no drawing since the previous one,
+and state or texture load macros that repeat the last identical one in the same array with nothing but
+drawing in between.
+
+Usage:
+  tools/dl_analyzer.py build/us_n64/actors/*.elf build/us_n64/levels/*/leveldata.elf
+  tools/dl_analyzer.py --sort pipesync --top 20 build/us_n64/actors/group0.elf
+  tools/dl_analyzer.py --rewrite actors/goomba/model.inc.c [--write]
+"""
+
+import argparse
+import difflib
+import re
+import struct
+import sys
+
+# ELF constants
+SHT_SYMTAB = 2
+STT_OBJECT = 1
+
+# F3DEX2 opcodes
+G_VTX = 0x01
+G_MODIFYVTX = 0x02
+G_CULLDL = 0x03
+G_BRANCH_Z = 0x04
+G_TRI1 = 0x05
+G_TRI2 = 0x06
+G_QUAD = 0x07
+G_LINE3D = 0x08
+G_SPECIAL_3 = 0xD3
+G_SPECIAL_2 = 0xD4
+G_SPECIAL_1 = 0xD5
+G_DMA_IO = 0xD6
+G_TEXTURE = 0xD7
+G_POPMTX = 0xD8
+G_GEOMETRYMODE = 0xD9
+G_MTX = 0xDA
+G_MOVEWORD = 0xDB
+G_MOVEMEM = 0xDC
+G_LOAD_UCODE = 0xDD
+G_DL = 0xDE
+G_ENDDL = 0xDF
+G_NOOP = 0xE0
+G_RDPHALF_1 = 0xE1
+G_SETOTHERMODE_L = 0xE2
+G_SETOTHERMODE_H = 0xE3
+G_TEXRECT = 0xE4
+G_TEXRECTFLIP = 0xE5
+G_RDPLOADSYNC = 0xE6
+G_RDPPIPESYNC = 0xE7
+G_RDPTILESYNC = 0xE8
+G_RDPFULLSYNC = 0xE9
+G_SETKEYGB = 0xEA
+G_SETKEYR = 0xEB
+G_SETCONVERT = 0xEC
+G_SETSCISSOR = 0xED
+G_SETPRIMDEPTH = 0xEE
+G_RDPSETOTHERMODE = 0xEF
+G_LOADTLUT = 0xF0
+G_RDPHALF_2 = 0xF1
+G_SETTILESIZE = 0xF2
+G_LOADBLOCK = 0xF3
+G_LOADTILE = 0xF4
+G_SETTILE = 0xF5
+G_FILLRECT = 0xF6
+G_SETFILLCOLOR = 0xF7
+G_SETFOGCOLOR = 0xF8
+G_SETBLENDCOLOR = 0xF9
+G_SETPRIMCOLOR = 0xFA
+G_SETENVCOLOR = 0xFB
+G_SETCOMBINE = 0xFC
+G_SETTIMG = 0xFD
+G_SETZIMG = 0xFE
+G_SETCIMG = 0xFF
+
+KNOWN_OPCODES = {
+    0x00, G_VTX, G_MODIFYVTX, G_CULLDL, G_BRANCH_Z, G_TRI1, G_TRI2, G_QUAD, G_LINE3D,
+    G_SPECIAL_3, G_SPECIAL_2, G_SPECIAL_1, G_DMA_IO, G_TEXTURE, G_POPMTX, G_GEOMETRYMODE,
+    G_MTX, G_MOVEWORD, G_MOVEMEM, G_LOAD_UCODE, G_DL, G_ENDDL,
+} | set(range(G_NOOP, 0x100))
+
+# Commands that draw something on the RDP.
+PRIMITIVE_OPCODES = {G_TRI1, G_TRI2, G_QUAD, G_LINE3D, G_TEXRECT, G_TEXRECTFLIP, G_FILLRECT}
+
+LOAD_OPCODES = {G_LOADBLOCK, G_LOADTILE, G_LOADTLUT}
+COLOR_OPCODES = {G_SETFILLCOLOR, G_SETFOGCOLOR, G_SETBLENDCOLOR, G_SETPRIMCOLOR, G_SETENVCOLOR}
+
+COLUMNS = [
+    ("cmds", "cmds"),
+    ("tris", "tris"),
+    ("vtx", "vtx_loads", "vtx_loaded"),
+    ("unused", "vtx_unused"),
+    ("merge", "vtx_mergeable"),
+    ("tex", "tex_loads", "tex_redundant"),
+    ("pipesync", "pipe_syncs", "pipe_syncs_wasted"),
+    ("tilesync", "tile_syncs", "tile_syncs_wasted"),
+    ("modes", "mode_changes", "mode_redundant"),
+]
+
+
+class ElfFile:
+    """Minimal reader for the big endian 32-bit ELFs the segments are linked into."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 2:
+            raise ValueError(f"{path}: not a big endian 32-bit ELF")
+
+        shoff, = struct.unpack_from(">I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(">HHH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            fields = struct.unpack_from(">IIIIIIIIII", self.data, shoff + i * shentsize)
+            self.sections.append({
+                "name_off": fields[0], "type": fields[1], "addr": fields[3], "offset": fields[4],
+                "size": fields[5], "link": fields[6], "entsize": fields[9],
+            })
+        shstr = self.sections[shstrndx]
+        for section in self.sections:
+            section["name"] = self.read_str(shstr["offset"] + section["name_off"])
+
+    def read_str(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("ascii", "replace")
+
+    def symbols(self):
+        for section in self.sections:
+            if section["type"] != SHT_SYMTAB:
+                continue
+            strtab = self.sections[section["link"]]
+            for i in range(section["size"] // section["entsize"]):
+                name_off, value, size, info, other, shndx = struct.unpack_from(
+                    ">IIIBBH", self.data, section["offset"] + i * section["entsize"])
+                if shndx == 0 or shndx >= len(self.sections):
+                    continue
+                yield {
+                    "name": self.read_str(strtab["offset"] + name_off), "value": value, "size": size,
+                    "type": info & 0xF, "section": self.sections[shndx],
+                }
+
+    def read(self, section, addr, size):
+        start = section["offset"] + (addr - section["addr"])
+        return self.data[start:start + size]
+
+
+def decode_commands(data):
+    return [struct.unpack_from(">II", data, i) for i in range(0, len(data), 8)]
+
+
+def looks_like_display_list(commands):
+    if not commands or (commands[-1][0] >> 24) != G_ENDDL:
+        return False
+    return all((w0 >> 24) in KNOWN_OPCODES for w0, w1 in commands)
+
+
+class DisplayListStats:
+    def __init__(self, name, source):
+        self.name = name
+        self.source = source
+        for column in COLUMNS:
+            for field in column[1:]:
+                setattr(self, field, 0)
+
+    def wasted(self):
+        return (self.vtx_mergeable + self.tex_redundant + self.pipe_syncs_wasted
+                + self.tile_syncs_wasted + self.mode_redundant)
+
+
+class KnownState:
+    """A register where only some of the bits may be known."""
+
+    def __init__(self):
+        self.known = 0
+        self.value = 0
+
+    def set_bits(self, mask, value):
+        redundant = (self.known & mask) == mask and (self.value & mask) == (value & mask)
+        self.known |= mask
+        self.value = (self.value & ~mask) | (value & mask)
+        return redundant
+
+    def forget(self):
+        self.known = 0
+
+
+def analyze_display_list(name, source, commands, vtx_cache_size):
+    stats = DisplayListStats(name, source)
+    stats.cmds = len(commands)
+
+    # Vertex cache: for each slot, whether the vertex loaded into it has been used yet.
+    slots = [None] * vtx_cache_size
+    last_load_size = None  # size of the previous vertex load, while it can still be merged with
+
+    # RDP state
+    drawn_since_pipe_sync = True   # unknown at the start, so assume something was drawn
+    drawn_since_tile_sync = True
+    timg = None
+    tiles = {}
+    tmem = {}  # tmem address in bytes -> (size, load key)
+    othermode = KnownState()
+    geometry_mode = KnownState()
+    combine = None
+    colors = {}
+
+    def use_vertex(index):
+        if 0 <= index < vtx_cache_size and slots[index] is not None:
+            slots[index] = True
+
+    def retire_slots(start, end):
+        for i in range(start, min(end, vtx_cache_size)):
+            if slots[i] is False:
+                stats.vtx_unused += 1
+            slots[i] = None
+
+    def unknown_state():
+        nonlocal drawn_since_pipe_sync, drawn_since_tile_sync, combine, timg
+        drawn_since_pipe_sync = True
+        drawn_since_tile_sync = True
+        othermode.forget()
+        geometry_mode.forget()
+        combine = None
+        timg = None
+        colors.clear()
+        tiles.clear()
+        tmem.clear()
+
+    for w0, w1 in commands:
+        op = w0 >> 24
+
+        if op != G_VTX and op not in (G_TRI1, G_TRI2, G_QUAD):
+            last_load_size = None
+
+        if op == G_VTX:
+            count = (w0 >> 12) & 0xFF
+            end = (w0 & 0xFF) >> 1
+            start = end - count
+            stats.vtx_loads += 1
+            stats.vtx_loaded += count
+            if last_load_size is not None and last_load_size + count <= vtx_cache_size:
+                stats.vtx_mergeable += 1
+            last_load_size = count
+            retire_slots(start, end)
+            for i in range(max(start, 0), min(end, vtx_cache_size)):
+                slots[i] = False
+        elif op in (G_TRI1, G_TRI2, G_QUAD):
+            for index in ((w0 >> 16) & 0xFF, (w0 >> 8) & 0xFF, w0 & 0xFF):
+                use_vertex(index // 2)
+            stats.tris += 1
+            if op != G_TRI1:
+                for index in ((w1 >> 16) & 0xFF, (w1 >> 8) & 0xFF, w1 & 0xFF):
+                    use_vertex(index // 2)
+                stats.tris += 1
+        elif op in (G_DL, G_BRANCH_Z, G_LOAD_UCODE):
+            unknown_state()
+        elif op == G_RDPPIPESYNC:
+            stats.pipe_syncs += 1
+            if not drawn_since_pipe_sync:
+                stats.pipe_syncs_wasted += 1
+            drawn_since_pipe_sync = False
+        elif op == G_RDPTILESYNC:
+            stats.tile_syncs += 1
+            if not drawn_since_tile_sync:
+                stats.tile_syncs_wasted += 1
+            drawn_since_tile_sync = False
+        elif op == G_SETTIMG:
+            timg = (w0 & 0x00FFFFFF, w1)
+        elif op == G_SETTILE:
+            tile = (w1 >> 24) & 0x7
+            tiles[tile] = {"tmem": (w0 & 0x1FF) * 8, "siz": (w0 >> 19) & 0x3, "line": (w0 >> 9) & 0x1FF}
+        elif op in LOAD_OPCODES:
+            stats.tex_loads += 1
+            tile = tiles.get((w1 >> 24) & 0x7)
+            if tile is None or timg is None:
+                tmem.clear()
+                continue
+            siz = (timg[0] >> 19) & 0x3
+            if op == G_LOADBLOCK:
+                texels = ((w1 >> 12) & 0xFFF) - ((w0 >> 12) & 0xFFF) + 1
+                size = (texels << siz) >> 1
+            elif op == G_LOADTILE:
+                width = ((((w1 >> 12) & 0xFFF) - ((w0 >> 12) & 0xFFF)) >> 2) + 1
+                height = (((w1 & 0xFFF) - (w0 & 0xFFF)) >> 2) + 1
+                size = tile["line"] * 8 * height if tile["line"] else (width * height << siz) >> 1
+            else:
+                size = (((w1 >> 14) & 0x3FF) + 1) * 2
+            start = tile["tmem"]
+            key = (op, timg, w0, w1 & 0x00FFFFFF, size)
+            if tmem.get(start) == (size, key):
+                stats.tex_redundant += 1
+                continue
+            for other_start, (other_size, _) in list(tmem.items()):
+                if other_start < start + size and start < other_start + other_size:
+                    del tmem[other_start]
+            tmem[start] = (size, key)
+        elif op in (G_SETOTHERMODE_L, G_SETOTHERMODE_H):
+            stats.mode_changes += 1
+            length = (w0 & 0xFF) + 1
+            shift = 32 - ((w0 >> 8) & 0xFF) - length
+            mask = ((1 << length) - 1) << shift
+            if op == G_SETOTHERMODE_H:
+                mask <<= 32
+                w1 <<= 32
+            if othermode.set_bits(mask, w1):
+                stats.mode_redundant += 1
+        elif op == G_RDPSETOTHERMODE:
+            stats.mode_changes += 1
+            if othermode.set_bits((1 << 56) - 1, ((w0 & 0xFFFFFF) << 32) | w1):
+                stats.mode_redundant += 1
+        elif op == G_GEOMETRYMODE:
+            stats.mode_changes += 1
+            clear = ~w0 & 0xFFFFFF
+            cleared = geometry_mode.set_bits(clear, 0) if clear else True
+            was_set = geometry_mode.set_bits(w1, w1) if w1 else True
+            if cleared and was_set:
+                stats.mode_redundant += 1
+        elif op == G_SETCOMBINE:
+            stats.mode_changes += 1
+            if combine == (w0, w1):
+                stats.mode_redundant += 1
+            combine = (w0, w1)
+        elif op in COLOR_OPCODES:
+            stats.mode_changes += 1
+            if colors.get(op) == (w0, w1):
+                stats.mode_redundant += 1
+            colors[op] = (w0, w1)
+
+        if op in PRIMITIVE_OPCODES or op in (G_DL, G_BRANCH_Z):
+            drawn_since_pipe_sync = True
+            drawn_since_tile_sync = True
+
+    retire_slots(0, vtx_cache_size)
+    return stats
+
+
+def analyze_elf(path, vtx_cache_size):
+    elf = ElfFile(path)
+    results = []
+    seen = set()
+
+    for symbol in elf.symbols():
+        section = symbol["section"]
+        if symbol["type"] != STT_OBJECT or symbol["size"] == 0 or symbol["size"] % 8 != 0:
+            continue
+        if not section["name"].startswith((".data", ".rodata")) or symbol["value"] in seen:
+            continue
+        commands = decode_commands(elf.read(section, symbol["value"], symbol["size"]))
+        if not looks_like_display_list(commands):
+            continue
+        seen.add(symbol["value"])
+        results.append(analyze_display_list(symbol["name"], path, commands, vtx_cache_size))
+
+    return results
+
+
+def format_column(stats, column):
+    values = [getattr(stats, field) for field in column[1:]]
+    return "/".join(str(v) for v in values)
+
+
+def print_report(results, sort, top, csv):
+    if sort == "wasted":
+        results.sort(key=lambda s: s.wasted(), reverse=True)
+    else:
+        field = next(column[-1] for column in COLUMNS if column[0] == sort)
+        results.sort(key=lambda s: getattr(s, field), reverse=True)
+    if top:
+        results = results[:top]
+
+    if csv:
+        fields = [field for column in COLUMNS for field in column[1:]]
+        print(",".join(["source", "name"] + fields))
+        for stats in results:
+            print(",".join([stats.source, stats.name] + [str(getattr(stats, f)) for f in fields]))
+        return
+
+    name_width = max([len("total")] + [len(s.name) for s in results])
+    header = f"{'name':<{name_width}}" + "".join(f"{column[0]:>12}" for column in COLUMNS)
+    print(header)
+    print("-" * len(header))
+    for stats in results:
+        print(f"{stats.name:<{name_width}}" + "".join(f"{format_column(stats, c):>12}" for c in COLUMNS))
+
+    total = DisplayListStats("total", "")
+    for stats in results:
+        for column in COLUMNS:
+            for field in column[1:]:
+                setattr(total, field, getattr(total, field) + getattr(stats, field))
+    print("-" * len(header))
+    print(f"{'total':<{name_width}}" + "".join(f"{format_column(total, c):>12}" for c in COLUMNS))
+
+
+# Source level rewrite
+
+GFX_ARRAY_RE = re.compile(r"^\s*(?:static\s+)?(?:const\s+)?Gfx\s+\w+\s*\[[^\]]*\]\s*=\s*\{")
+MACRO_RE = re.compile(r"^\s*(gs\w+)\s*\((.*)\)\s*,\s*(//.*)?$")
+
+SOURCE_DRAW_MACROS = re.compile(r"^gs(SP1Triangle|SP2Triangles|SP1Quadrangle|SPLine3D|SPTextureRectangle|DPFillRectangle)")
+SOURCE_BARRIER_MACROS = re.compile(r"^gs(SPDisplayList|SPBranchList|SPBranchLessZ|SPCullDisplayList|SPEndDisplayList|SPLoadUcode|DPSetTextureImage|DPSetTile|DPLoadBlock|DPLoadTile|DPLoadSync|DPTileSync)")
+# Macros that set a whole piece of state from their arguments alone.
+SOURCE_STATE_MACROS = {
+    "gsDPSetCombineMode": "combine", "gsDPSetCombineLERP": "combine",
+    "gsDPSetRenderMode": "rendermode", "gsDPSetCycleType": "cycletype",
+    "gsDPSetTextureFilter": "texfilter", "gsDPSetTextureLUT": "texlut",
+    "gsDPSetTexturePersp": "texpersp", "gsDPSetTextureLOD": "texlod",
+    "gsDPSetAlphaCompare": "alphacompare", "gsDPSetDepthSource": "depthsource",
+    "gsDPSetEnvColor": "envcolor", "gsDPSetPrimColor": "primcolor",
+    "gsDPSetFogColor": "fogcolor", "gsDPSetBlendColor": "blendcolor",
+    "gsSPTexture": "texture",
+}
+SOURCE_LOAD_MACROS = re.compile(r"^gsDPLoad(TextureBlock|TextureTile|TLUT|MultiBlock|MultiTile)")
+
+
+def rewrite_source(lines):
+    """Returns the lines of a model source with conservative redundancies removed."""
+    out = []
+    in_array = False
+
+    for line in lines:
+        if not in_array:
+            out.append(line)
+            if GFX_ARRAY_RE.match(line):
+                in_array = True
+                drawn_since_sync = True
+                state = {}
+                last_load = None
+            continue
+
+        if line.strip().startswith("};"):
+            in_array = False
+            out.append(line)
+            continue
+
+        match = MACRO_RE.match(line)
+        if not match:
+            out.append(line)
+            continue
+        macro, args = match.group(1), re.sub(r"\s+", "", match.group(2))
+
+        if macro == "gsDPPipeSync":
+            if not drawn_since_sync:
+                continue
+            drawn_since_sync = False
+        elif SOURCE_DRAW_MACROS.match(macro):
+            drawn_since_sync = True
+        elif macro in SOURCE_STATE_MACROS:
+            key = SOURCE_STATE_MACROS[macro]
+            if state.get(key) == (macro, args):
+                continue
+            state[key] = (macro, args)
+        elif SOURCE_LOAD_MACROS.match(macro):
+            if last_load == (macro, args):
+                continue
+            last_load = (macro, args)
+        elif SOURCE_BARRIER_MACROS.match(macro):
+            # Anything else can draw, load textures or change state that isn't tracked.
+            drawn_since_sync = True
+            state = {}
+            last_load = None
+        elif not macro.startswith("gsSPVertex"):
+            # Unknown macros (geometry mode, other modes, tile sizes) might depend on or change tracked state.
+            state = {}
+            last_load = None
+
+        out.append(line)
+
+    return out
+
+
+def rewrite_files(paths, write):
+    changed = False
+    for path in paths:
+        with open(path) as f:
+            lines = f.readlines()
+        new_lines = rewrite_source(lines)
+        if new_lines == lines:
+            continue
+        changed = True
+        if write:
+            with open(path, "w") as f:
+                f.writelines(new_lines)
+            print(f"{path}: removed {len(lines) - len(new_lines)} lines")
+        else:
+            sys.stdout.writelines(difflib.unified_diff(lines, new_lines, path, path))
+    return changed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the RSP/RDP cost of the display lists in segment ELFs.")
+    parser.add_argument("files", nargs="+", help="segment ELFs to analyze, or model sources with --rewrite")
+    parser.add_argument("--vtx-cache", type=int, default=32, help="vertex cache size of the microcode (default: 32)")
+    parser.add_argument("--sort", default="wasted", choices=["wasted"] + [c[0] for c in COLUMNS],
+                        help="column to sort by, from highest to lowest (default: wasted)")
+    parser.add_argument("--top", type=int, default=0, help="only show this many display lists")
+    parser.add_argument("--csv", action="store_true", help="print every field as CSV")
+    parser.add_argument("--rewrite", action="store_true",
+                        help="remove redundant commands from the given model sources, printing a diff")
+    parser.add_argument("--write", action="store_true", help="with --rewrite, edit the files in place")
+    args = parser.parse_args()
+
+    if args.rewrite:
+        rewrite_files(args.files, args.write)
+        return
+
+    results = []
+    for path in args.files:
+        try:
+            results += analyze_elf(path, args.vtx_cache)
+        except (OSError, ValueError) as e:
+            print(f"dl_analyzer: {e}", file=sys.stderr)
+    print_report(results, args.sort, args.top, args.csv)
+
+
+if __name__ == "__main__":
+    main()
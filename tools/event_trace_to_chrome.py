@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Event tracer to Chrome trace converter.
+
+Reads the packets that EVENT_TRACER sends over USB with UNF (see src/game/event_trace.h) and writes them
+as Chrome trace event JSON, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+
+UNFLoader saves every raw binary packet it receives to its own file, so any number of files can be given.
+They are read in the given order, and each file can also hold several packets back to back.
+
+  B / E events    become "B" / "E" duration events on the thread that recorded them
+                  (object updates are tagged with their behavior script address)
+  T events        become "C" counter events with the number of calls and their total time in microseconds
+  dropped events  (overwritten in the ring buffer before they were sent) become instant events
+
+Timestamps are osGetCount values, which wrap around every ~91 seconds. They are unwrapped assuming that
+no more than one wrap happens between two consecutive events.
+
+Usage:
+  tools/event_trace_to_chrome.py binaryout-*.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_PACKET_MAGIC = 0x54524345  # "TRCE"
+HEADER = struct.Struct(">III")  # magic, count, dropped
+EVENT = struct.Struct(">IIBBBx")  # timestamp, arg, id, phase, thread
+
+# OS_CPU_COUNTER / 1000000
+COUNTS_PER_USEC = 46.875
+
+# Must match enum TraceEventIDs.
+EVENT_NAMES = [
+    "FRAME",
+    "OBJECT",
+    "FIND FLOOR",
+    "AUDIO",
+    "GFX TASK",
+]
+TRACE_EVENT_OBJECT_UPDATE = 1
+
+# Must match enum TraceEventPhases.
+TRACE_PHASE_BEGIN = 0
+TRACE_PHASE_END = 1
+TRACE_PHASE_TOTAL = 2
+
+
+def read_packets(data):
+    """Yields (dropped, events) for every packet in data."""
+    pos = 0
+    while pos + HEADER.size <= len(data):
+        magic, count, dropped = HEADER.unpack_from(data, pos)
+        if magic != TRACE_PACKET_MAGIC:
+            # Not the start of a packet, resync on the next word.
+            pos += 4
+            continue
+
+        pos += HEADER.size
+        end = pos + count * EVENT.size
+        if end > len(data):
+            print("warning: truncated packet, %d of %d events" % ((len(data) - pos) // EVENT.size, count),
+                  file=sys.stderr)
+            end = pos + ((len(data) - pos) // EVENT.size) * EVENT.size
+
+        yield dropped, [EVENT.unpack_from(data, offset) for offset in range(pos, end, EVENT.size)]
+        pos = end
+
+
+class Clock:
+    """Unwraps the 32 bit count register into microseconds since the first event."""
+
+    def __init__(self):
+        self.first = None
+        self.last = 0
+        self.high = 0
+
+    def usec(self, timestamp):
+        if self.first is None:
+            self.first = timestamp
+            self.last = timestamp
+        if timestamp < self.last:
+            self.high += 1 << 32
+        self.last = timestamp
+        return ((self.high + timestamp) - self.first) / COUNTS_PER_USEC
+
+
+def event_name(event_id):
+    return EVENT_NAMES[event_id] if event_id < len(EVENT_NAMES) else "EVENT %d" % event_id
+
+
+def convert(files):
+    clock = Clock()
+    trace = []
+    last_ts = 0.0
+
+    for path in files:
+        with open(path, "rb") as f:
+            data = f.read()
+
+        for dropped, events in read_packets(data):
+            if dropped:
+                trace.append({"name": "%d events dropped" % dropped, "ph": "i", "s": "g",
+                              "ts": last_ts, "pid": 0, "tid": 0})
+
+            for timestamp, arg, event_id, phase, thread in events:
+                ts = clock.usec(timestamp)
+                last_ts = ts
+                name = event_name(event_id)
+
+                if phase == TRACE_PHASE_TOTAL:
+                    trace.append({"name": name, "ph": "C", "ts": ts, "pid": 0,
+                                  "args": {"calls": arg >> 16, "usec": arg & 0xFFFF}})
+                    continue
+
+                entry = {"name": name, "ph": "B" if phase == TRACE_PHASE_BEGIN else "E",
+                         "ts": ts, "pid": 0, "tid": thread}
+                if event_id == TRACE_EVENT_OBJECT_UPDATE:
+                    entry["args"] = {"behavior": "0x%08X" % arg}
+                elif arg:
+                    entry["args"] = {"arg": arg}
+                trace.append(entry)
+
+    return trace
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert EVENT_TRACER USB packets to Chrome trace event JSON.")
+    parser.add_argument("files", nargs="+", help="raw binary files saved by UNFLoader")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    trace = {"traceEvents": convert(args.files), "displayTimeUnit": "ms"}
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
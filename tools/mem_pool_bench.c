@@ -0,0 +1,264 @@
+/*
+ * Host-side stress benchmark for the MemoryPool allocator.
+ *
+ * Runs the same random allocation/free workload against the TLSF allocator in src/boot/tlsf.c and
+ * against the first-fit free list allocator MemoryPools used before it (copied below), and reports
+ * the time per operation, how many allocations failed, the high water mark and the fragmentation
+ * (1 - largest free block / free space) at the end.
+ *
+ * Every allocation is filled with a pattern that is checked again when it's freed, so this also
+ * catches allocators handing out overlapping blocks.
+ *
+ * Usage:
+ *   cc -O2 -Iinclude/n64 -Isrc/boot tools/mem_pool_bench.c src/boot/tlsf.c -o mem_pool_bench
+ *   ./mem_pool_bench [pool size] [operations] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <PR/ultratypes.h>
+
+#include "tlsf.h"
+
+#define MAX_LIVE 512
+
+/*
+ * The previous MemoryPool allocator: a singly linked, address ordered free list.
+ * Sizes are aligned to the size of a pointer instead of 4, so the block headers stay aligned on 64-bit hosts.
+ */
+struct MemoryBlock {
+    struct MemoryBlock *next;
+    u32 size;
+};
+
+struct FirstFitPool {
+    u32 totalSpace;
+    struct MemoryBlock *firstBlock;
+    struct MemoryBlock freeList;
+    u32 usedSpace;
+    u32 highWater;
+};
+
+#define FIRST_FIT_ALIGN(x) (((x) + (sizeof(void *) - 1)) & ~(sizeof(void *) - 1))
+
+static void first_fit_init(struct FirstFitPool *pool, void *start, u32 size) {
+    memset(pool, 0, sizeof(*pool));
+    pool->totalSpace = FIRST_FIT_ALIGN(size);
+    pool->firstBlock = start;
+    pool->freeList.next = start;
+    pool->firstBlock->next = NULL;
+    pool->firstBlock->size = pool->totalSpace;
+}
+
+static void *first_fit_alloc(struct FirstFitPool *pool, u32 size) {
+    struct MemoryBlock *freeBlock = &pool->freeList;
+    void *addr = NULL;
+
+    size = FIRST_FIT_ALIGN(size) + sizeof(struct MemoryBlock);
+    while (freeBlock->next != NULL) {
+        if (freeBlock->next->size >= size) {
+            addr = (u8 *) freeBlock->next + sizeof(struct MemoryBlock);
+            if (freeBlock->next->size - size <= sizeof(struct MemoryBlock)) {
+                freeBlock->next = freeBlock->next->next;
+            } else {
+                struct MemoryBlock *newBlock = (struct MemoryBlock *) ((u8 *) freeBlock->next + size);
+                newBlock->size = freeBlock->next->size - size;
+                newBlock->next = freeBlock->next->next;
+                freeBlock->next->size = size;
+                freeBlock->next = newBlock;
+            }
+            break;
+        }
+        freeBlock = freeBlock->next;
+    }
+    if (addr != NULL) {
+        pool->usedSpace += ((struct MemoryBlock *) addr - 1)->size;
+        if (pool->usedSpace > pool->highWater) {
+            pool->highWater = pool->usedSpace;
+        }
+    }
+    return addr;
+}
+
+static void first_fit_free(struct FirstFitPool *pool, void *addr) {
+    struct MemoryBlock *block = (struct MemoryBlock *) ((u8 *) addr - sizeof(struct MemoryBlock));
+    struct MemoryBlock *freeList = pool->freeList.next;
+
+    pool->usedSpace -= block->size;
+    if (pool->freeList.next == NULL) {
+        pool->freeList.next = block;
+        block->next = NULL;
+    } else {
+        if (block < pool->freeList.next) {
+            if ((u8 *) pool->freeList.next == (u8 *) block + block->size) {
+                block->size += freeList->size;
+                block->next = freeList->next;
+                pool->freeList.next = block;
+            } else {
+                block->next = pool->freeList.next;
+                pool->freeList.next = block;
+            }
+        } else {
+            while (freeList->next != NULL) {
+                if (freeList < block && block < freeList->next) {
+                    break;
+                }
+                freeList = freeList->next;
+            }
+            if ((u8 *) freeList + freeList->size == (u8 *) block) {
+                freeList->size += block->size;
+                block = freeList;
+            } else {
+                block->next = freeList->next;
+                freeList->next = block;
+            }
+            if (block->next != NULL && (u8 *) block->next == (u8 *) block + block->size) {
+                block->size = block->size + block->next->size;
+                block->next = block->next->next;
+            }
+        }
+    }
+}
+
+static void first_fit_get_stats(struct FirstFitPool *pool, struct TlsfStats *stats) {
+    stats->totalSpace = pool->totalSpace;
+    stats->usedSpace = pool->usedSpace;
+    stats->highWater = pool->highWater;
+    stats->largestFree = 0;
+    for (struct MemoryBlock *block = pool->freeList.next; block != NULL; block = block->next) {
+        if (block->size > stats->largestFree) {
+            stats->largestFree = block->size;
+        }
+    }
+}
+
+/*
+ * Wrappers so both allocators can run the same workload.
+ */
+struct Allocator {
+    const char *name;
+    void (*init)(void *pool, void *start, u32 size);
+    void *(*alloc)(void *pool, u32 size);
+    void (*free)(void *pool, void *addr);
+    void (*get_stats)(void *pool, struct TlsfStats *stats);
+};
+
+static const struct Allocator sAllocators[] = {
+    { "first-fit", (void *) first_fit_init, (void *) first_fit_alloc, (void *) first_fit_free, (void *) first_fit_get_stats },
+    { "tlsf",      (void *) tlsf_init,      (void *) tlsf_alloc,      (void *) tlsf_free,      (void *) tlsf_get_stats },
+};
+
+struct Allocation {
+    u8 *addr;
+    u32 size;
+    u8 pattern;
+};
+
+static u32 sRandState;
+
+static u32 bench_rand(void) {
+    sRandState = (sRandState * 1103515245 + 12345);
+    return (sRandState >> 8);
+}
+
+/**
+ * Sizes roughly follow what the game allocates from its pools: lots of small text labels and
+ * chain segments, some puppycam volumes and envfx buffers, and the occasional painting mesh.
+ */
+static u32 bench_rand_size(void) {
+    u32 r = (bench_rand() % 100);
+
+    if (r < 60) {
+        return (8 + (bench_rand() % 56));
+    } else if (r < 90) {
+        return (64 + (bench_rand() % 448));
+    } else {
+        return (512 + (bench_rand() % 2560));
+    }
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+static int run(const struct Allocator *allocator, u32 poolSize, u32 numOps, u32 seed) {
+    static struct Allocation live[MAX_LIVE];
+    static union {
+        struct TlsfPool tlsf;
+        struct FirstFitPool firstFit;
+    } pool;
+    u8 *memory = malloc(poolSize);
+    u32 numLive = 0, numAllocs = 0, numFrees = 0, numFailed = 0;
+    struct TlsfStats stats;
+    int errors = 0;
+
+    sRandState = seed;
+    allocator->init(&pool, memory, poolSize);
+
+    double start = now();
+    for (u32 op = 0; op < numOps; op++) {
+        if (numLive > 0 && (numLive == MAX_LIVE || (bench_rand() % 100) < 48)) {
+            u32 index = (bench_rand() % numLive);
+            struct Allocation *a = &live[index];
+
+            for (u32 i = 0; i < a->size; i++) {
+                if (a->addr[i] != a->pattern) {
+                    errors++;
+                    break;
+                }
+            }
+            allocator->free(&pool, a->addr);
+            live[index] = live[--numLive];
+            numFrees++;
+        } else {
+            u32 size = bench_rand_size();
+            u8 *addr = allocator->alloc(&pool, size);
+
+            if (addr == NULL) {
+                numFailed++;
+                continue;
+            }
+            if (addr < memory || (addr + size) > (memory + poolSize)) {
+                errors++;
+            }
+            live[numLive].addr = addr;
+            live[numLive].size = size;
+            live[numLive].pattern = (u8) (op | 1);
+            memset(addr, live[numLive].pattern, size);
+            numLive++;
+            numAllocs++;
+        }
+    }
+    double elapsed = now() - start;
+
+    allocator->get_stats(&pool, &stats);
+    u32 freeSpace = (stats.totalSpace - stats.usedSpace);
+    printf("%-10s %10.1f %8u %8u %8u %#10x %#10x %7.1f%%%s\n", allocator->name,
+           (elapsed * 1e9) / (numAllocs + numFrees), numAllocs, numFrees, numFailed, stats.highWater,
+           stats.largestFree, (freeSpace ? (100.0 - (100.0 * stats.largestFree) / freeSpace) : 0.0),
+           (errors ? "  CORRUPTED" : ""));
+
+    free(memory);
+    return errors;
+}
+
+int main(int argc, char **argv) {
+    u32 poolSize = (argc > 1) ? strtoul(argv[1], NULL, 0) : 0x4000;
+    u32 numOps   = (argc > 2) ? strtoul(argv[2], NULL, 0) : 1000000;
+    u32 seed     = (argc > 3) ? strtoul(argv[3], NULL, 0) : 1;
+    int errors = 0;
+
+    printf("pool size %#x, %u operations, seed %u\n\n", poolSize, numOps, seed);
+    printf("%-10s %10s %8s %8s %8s %10s %10s %8s\n", "allocator", "ns/op", "allocs", "frees", "failed",
+           "highwater", "largest", "frag");
+    for (size_t i = 0; i < sizeof(sAllocators) / sizeof(sAllocators[0]); i++) {
+        errors += run(&sAllocators[i], poolSize, numOps, seed);
+    }
+
+    return (errors != 0);
+}
@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+"""
+Area display list splitter.
+
+Splits the display lists of an area model (levels/*/areas/*/*/model.inc.c) into spatially bounded chunks,
+so that each chunk can be wrapped in a GEO_CULLING_BOUNDS node and skipped when it's off screen.
+
+Every triangle is put in the grid cell its centroid falls in. Each non-empty cell gets a copy of the display
+list with only its own triangles, which reuses the original vertex buffers, so no vertex data is duplicated.
+State commands (texture loads, combine modes, lights, ...) are kept in their original order and only sent
+right before the next triangle that's drawn, so every triangle is drawn with exactly the same state as before.
+State that's fully overwritten before anything is drawn with it is left out.
+
+Two files are written:
+  <output>.inc.c  the model with its split display lists replaced by their chunks, to be included in
+                  leveldata.c instead of the model itself
+  <output>.h      their declarations, and a GEO_CHUNKS_<display list>(layer) geo macro for each display list,
+                  which GEO_CHUNKED_DISPLAY_LIST(layer, displayList) expands to in the area's geo layout
+
+Triangles are drawn in a different order after splitting, so only use this for layers where the draw order
+doesn't matter (LAYER_OPAQUE, LAYER_ALPHA, ...). Display lists that can't be split safely (preprocessor
+conditionals, display lists from other files, unknown vertex buffers) and ones that end up in a single chunk
+are drawn as they were.
+
+Usage:
+  tools/split_area_dl.py levels/wdw/areas/1/1/model.inc.c build/us_n64/levels/wdw/areas/1/1/model.chunks
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_CHUNK_SIZE = 4096
+
+ARRAY_START = re.compile(r"^(static\s+)?const\s+(Vtx|Gfx)\s+(\w+)\[\]\s*=\s*\{")
+VTX_POS = re.compile(r"\{\{\{\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)\s*\}")
+COMMAND = re.compile(r"^(\w+)\((.*)\),?\s*(//.*)?$")
+VTX_ADDR = re.compile(r"^(\w+)(?:\s*\+\s*(\d+))?$")
+CALL = re.compile(r"gsSPDisplayList\((\w+)\)")
+
+# G_TX_LOADTILE
+LOAD_TILE = "7"
+
+TEXEL_BYTES = {"G_IM_SIZ_4b": 0.5, "G_IM_SIZ_8b": 1, "G_IM_SIZ_16b": 2, "G_IM_SIZ_32b": 4}
+
+
+class Unsplittable(Exception):
+    pass
+
+
+def split_args(args):
+    """Splits the arguments of a Gfx macro at the top level commas."""
+    out, depth, cur = [], 0, ""
+    for ch in args:
+        if ch == "," and depth == 0:
+            out.append(cur.strip())
+            cur = ""
+            continue
+        depth += (ch == "(") - (ch == ")")
+        cur += ch
+    if cur.strip():
+        out.append(cur.strip())
+    return out
+
+
+def parse_model(path):
+    """Returns the lines of a model.inc.c, and the vertex positions, Gfx commands and lines of its arrays."""
+    vertices, displayLists, exported, lineRanges = {}, {}, [], {}
+    current = None
+
+    with open(path) as f:
+        lines = f.readlines()
+
+    for lineNum, line in enumerate(lines):
+        stripped = line.strip()
+        if current is None:
+            m = ARRAY_START.match(stripped)
+            if m:
+                current = (m.group(2), m.group(3))
+                lineRanges[current[1]] = [lineNum, None]
+                if current[0] == "Vtx":
+                    vertices[current[1]] = []
+                else:
+                    displayLists[current[1]] = []
+                    if not m.group(1):
+                        exported.append(current[1])
+            continue
+
+        if stripped.startswith("};"):
+            lineRanges[current[1]][1] = lineNum + 1
+            current = None
+        elif current[0] == "Vtx":
+            m = VTX_POS.search(stripped)
+            if m:
+                vertices[current[1]].append(tuple(int(x) for x in m.groups()))
+        elif stripped:
+            displayLists[current[1]].append(stripped)
+
+    return lines, vertices, displayLists, exported, lineRanges
+
+
+def command_of(line):
+    if line.startswith("#"):
+        raise Unsplittable("preprocessor conditional")
+    m = COMMAND.match(line)
+    if not m:
+        raise Unsplittable("can't parse '%s'" % line)
+    return m.group(1), split_args(m.group(2))
+
+
+def state_key(name, args, loadTileTmem):
+    """
+    Commands with the same key fully overwrite each other, so only the last one before a triangle is needed.
+    Returns None for commands that always have to be kept.
+    """
+    simple = {
+        "gsDPSetCombineMode": "combine",
+        "gsDPSetCombineLERP": "combine",
+        "gsDPSetRenderMode": "render mode",
+        "gsDPSetCycleType": "cycle type",
+        "gsDPSetDepthSource": "depth source",
+        "gsDPSetEnvColor": "env color",
+        "gsDPSetPrimColor": "prim color",
+        "gsDPSetFogColor": "fog color",
+        "gsSPFogPosition": "fog",
+        "gsSPFogFactor": "fog",
+        "gsSPTexture": "texture",
+    }
+    if name in simple:
+        return (simple[name],)
+    if name == "gsDPSetTile":
+        return ("tile", args[4])
+    if name == "gsDPSetTileSize":
+        return ("tile size", args[0])
+    if name == "gsSPLightColor":
+        return ("light", args[0])
+    return None
+
+
+class ChunkWriter:
+    """Walks a display list tree and writes the commands one grid cell needs."""
+
+    def __init__(self, splitter, cell):
+        self.splitter = splitter
+        self.cell = cell
+        self.vtxSlots = [None] * 64
+        self.pending = []  # [key, line, vertex range]
+        self.loadTileTmem = None
+        self.bounds = None
+
+    def queue(self, line, key=None, vtxRange=None):
+        if key is not None:
+            self.pending = [p for p in self.pending if p[0] != key]
+        if vtxRange is not None:
+            start, end = vtxRange
+            self.pending = [p for p in self.pending
+                            if p[2] is None or not (start <= p[2][0] and p[2][1] <= end)]
+        self.pending.append([key, line, vtxRange])
+
+    def flush(self, out):
+        out.extend(p[1] for p in self.pending)
+        self.pending = []
+
+    def queue_texture_load(self, lines, size):
+        # A load is only overwritten by a later one to the same TMEM address that's at least as big.
+        if size is not None and self.loadTileTmem is not None:
+            self.pending = [p for p in self.pending
+                            if not (p[0] is not None and p[0][0] == "load" and p[0][1] == self.loadTileTmem
+                                    and p[0][2] is not None and p[0][2] <= size)]
+        # The load tile this load goes through has to be set up as it was, even if it's changed again later.
+        for p in self.pending:
+            if p[0] is not None and p[0][0] == "tile" and p[0][1] in ("G_TX_LOADTILE", LOAD_TILE):
+                p[0] = None
+        key = ("load", self.loadTileTmem, size)
+        for line in lines:
+            self.pending.append([key, line, None])
+
+    def draw(self, out, tris, line):
+        ours = [t for t in tris if self.splitter.cell_of([self.vtxSlots[int(i, 0)] for i in t[:3]]) == self.cell]
+        if not ours:
+            return
+        self.flush(out)
+        if len(ours) == len(tris):
+            out.append(line)
+        else:
+            for t in ours:
+                out.append("gsSP1Triangle(%s, %s, %s, %s)," % t)
+        for t in ours:
+            for i in t[:3]:
+                self.grow_bounds(self.vtxSlots[int(i, 0)])
+
+    def grow_bounds(self, pos):
+        if self.bounds is None:
+            self.bounds = [list(pos), list(pos)]
+        for axis in range(3):
+            self.bounds[0][axis] = min(self.bounds[0][axis], pos[axis])
+            self.bounds[1][axis] = max(self.bounds[1][axis], pos[axis])
+
+    def walk(self, name, isRoot=False):
+        """Writes name's commands for this cell, returns the name of its chunk or None if it's empty."""
+        out = []
+        lines = self.splitter.displayLists[name]
+        i = 0
+
+        while i < len(lines):
+            line = lines[i]
+            cmd, args = command_of(line)
+            i += 1
+
+            if cmd == "gsSPEndDisplayList":
+                break
+            elif cmd == "gsSPVertex":
+                buf, offset = self.splitter.vertex_buffer(args[0])
+                count, dest = int(args[1], 0), int(args[2], 0)
+                for n in range(count):
+                    self.vtxSlots[dest + n] = buf[offset + n]
+                self.queue(line, vtxRange=(dest, dest + count))
+            elif cmd == "gsSP1Triangle":
+                self.draw(out, [tuple(args[0:4])], line)
+            elif cmd == "gsSP2Triangles":
+                self.draw(out, [tuple(args[0:4]), tuple(args[4:8])], line)
+            elif cmd == "gsSPDisplayList":
+                if args[0] not in self.splitter.displayLists:
+                    raise Unsplittable("calls %s from another file" % args[0])
+                child = self.walk(args[0])
+                if child is not None:
+                    out.append("gsSPDisplayList(%s)," % child)
+            elif cmd == "gsDPSetTextureImage" and i + 1 < len(lines) \
+                    and lines[i].startswith("gsDPLoadSync") and lines[i + 1].startswith("gsDPLoadBlock"):
+                loadArgs = split_args(COMMAND.match(lines[i + 1]).group(2))
+                try:
+                    size = (eval(loadArgs[3], {"__builtins__": {}}) + 1) * TEXEL_BYTES[args[1]]
+                except Exception:
+                    size = None
+                self.queue_texture_load([line, lines[i], lines[i + 1]], size)
+                i += 2
+            else:
+                if cmd == "gsDPSetTile" and args[4] in ("G_TX_LOADTILE", LOAD_TILE):
+                    self.loadTileTmem = args[3]
+                self.queue(line, key=state_key(cmd, args, self.loadTileTmem))
+
+        if isRoot:
+            # Whatever state is left still has to be set for whatever is drawn after this display list.
+            # Vertices aren't, every display list loads its own.
+            self.pending = [p for p in self.pending if p[2] is None]
+            self.flush(out)
+
+        if not out:
+            return None
+
+        chunkName = self.splitter.unique_name("%s_chunk_%d" % (name, self.splitter.cells.index(self.cell)))
+        self.splitter.output.append((chunkName, isRoot, out + ["gsSPEndDisplayList(),"]))
+        return chunkName
+
+
+class Splitter:
+    def __init__(self, vertices, displayLists, chunkSize):
+        self.vertices = vertices
+        self.displayLists = displayLists
+        self.chunkSize = chunkSize
+        self.cells = []
+        self.output = []
+        self.names = set()
+
+    def unique_name(self, name):
+        # Display lists called more than once get a chunk for every call.
+        unique, n = name, 1
+        while unique in self.names:
+            unique = "%s_%d" % (name, n)
+            n += 1
+        self.names.add(unique)
+        return unique
+
+    def vertex_buffer(self, addr):
+        m = VTX_ADDR.match(addr)
+        if not m or m.group(1) not in self.vertices:
+            raise Unsplittable("unknown vertex buffer %s" % addr)
+        return self.vertices[m.group(1)], int(m.group(2) or 0)
+
+    def cell_of(self, positions):
+        if None in positions:
+            raise Unsplittable("draws vertices it never loads")
+        return tuple(int(sum(p[axis] for p in positions) / 3) // self.chunkSize for axis in range(3))
+
+    def find_cells(self, name, slots, cells):
+        for line in self.displayLists[name]:
+            cmd, args = command_of(line)
+            if cmd == "gsSPEndDisplayList":
+                break
+            if cmd == "gsSPVertex":
+                buf, offset = self.vertex_buffer(args[0])
+                for n in range(int(args[1], 0)):
+                    slots[int(args[2], 0) + n] = buf[offset + n]
+            elif cmd in ("gsSP1Triangle", "gsSP2Triangles"):
+                for t in range(0, len(args), 4):
+                    cell = self.cell_of([slots[int(i, 0)] for i in args[t:t + 3]])
+                    if cell not in cells:
+                        cells.append(cell)
+            elif cmd == "gsSPDisplayList":
+                if args[0] not in self.displayLists:
+                    raise Unsplittable("calls %s from another file" % args[0])
+                self.find_cells(args[0], slots, cells)
+
+    def split(self, name):
+        """Returns [(chunk name, bounds)] for a display list, or None if it's drawn as it is."""
+        cells = []
+        self.find_cells(name, [None] * 64, cells)
+        if len(cells) < 2:
+            return None
+
+        self.cells = sorted(cells)
+        outputStart = len(self.output)
+        chunks = []
+        for cell in self.cells:
+            writer = ChunkWriter(self, cell)
+            chunkName = writer.walk(name, isRoot=True)
+            if chunkName is not None and writer.bounds is not None:
+                chunks.append((chunkName, writer.bounds))
+        if len(chunks) < 2:
+            for chunkName, _, _ in self.output[outputStart:]:
+                self.names.discard(chunkName)
+            del self.output[outputStart:]
+            return None
+        return chunks
+
+
+def reachable(displayLists, roots):
+    """Returns the display lists in a model that roots call, including the roots themselves."""
+    found, stack = set(), list(roots)
+    while stack:
+        name = stack.pop()
+        if name in found or name not in displayLists:
+            continue
+        found.add(name)
+        for line in displayLists[name]:
+            stack.extend(CALL.findall(line))
+    return found
+
+
+def write_outputs(modelPath, outputBase, model, splitter):
+    lines, _, displayLists, exported, lineRanges = model
+    header = "// Generated by tools/split_area_dl.py from %s, don't edit.\n\n" % modelPath
+    results = {}
+
+    for name in exported:
+        try:
+            results[name] = splitter.split(name)
+        except Unsplittable as e:
+            print("%s: %s is drawn whole, %s" % (modelPath, name, e), file=sys.stderr)
+            results[name] = None
+
+    os.makedirs(os.path.dirname(outputBase) or ".", exist_ok=True)
+
+    # The split display lists are replaced by their chunks, unless something that wasn't split still calls them.
+    kept = reachable(displayLists, [name for name in exported if results[name] is None])
+    replaced = reachable(displayLists, [name for name in exported if results[name] is not None]) - kept
+    skipped = set()
+    for name in replaced:
+        skipped.update(range(*lineRanges[name]))
+
+    with open(outputBase + ".inc.c", "w") as f:
+        f.write(header)
+        f.writelines(line for lineNum, line in enumerate(lines) if lineNum not in skipped)
+        f.write("\n")
+        for chunkName, exportedChunk, lines in splitter.output:
+            f.write("%sconst Gfx %s[] = {\n" % ("" if exportedChunk else "static ", chunkName))
+            for line in lines:
+                f.write("    %s\n" % line)
+            f.write("};\n\n")
+
+    with open(outputBase + ".h", "w") as f:
+        f.write(header)
+        for name in exported:
+            for chunkName, _ in results[name] or []:
+                f.write("extern const Gfx %s[];\n" % chunkName)
+        for name in exported:
+            f.write("\n#define GEO_CHUNKS_%s(layer) \\\n" % name)
+            if results[name] is None:
+                f.write("    GEO_DISPLAY_LIST(layer, %s)\n" % name)
+                continue
+            nodes = []
+            for chunkName, (lo, hi) in results[name]:
+                nodes.append("    GEO_CULLING_BOUNDS(%d, %d, %d, %d, %d, %d), \\\n"
+                             "    GEO_OPEN_NODE(), \\\n"
+                             "        GEO_DISPLAY_LIST(layer, %s), \\\n"
+                             "    GEO_CLOSE_NODE()" % (*lo, *hi, chunkName))
+            f.write(", \\\n".join(nodes) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Split an area model's display lists into bounded chunks.")
+    parser.add_argument("model", help="area model.inc.c")
+    parser.add_argument("output", help="output path without extension, .inc.c and .h are appended")
+    parser.add_argument("--chunk-size", type=int, default=DEFAULT_CHUNK_SIZE,
+                        help="size of the grid cells in units (default: %d)" % DEFAULT_CHUNK_SIZE)
+    args = parser.parse_args()
+
+    model = parse_model(args.model)
+    write_outputs(args.model, args.output, model, Splitter(model[1], model[2], args.chunk_size))
+
+
+if __name__ == "__main__":
+    main()